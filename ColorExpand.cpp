@@ -0,0 +1,78 @@
+#include "ColorExpand.h"
+
+static uint16_t expandLut[256][8];   // 4 KB: [mask byte][pixel], wire byte order
+static uint16_t lutFg = 0, lutBg = 0;
+static bool lutValid = false;
+
+// RGB565 with the bytes swapped, so a little-endian store puts the high byte first
+static inline uint16_t wireOrder(uint16_t c) { return (uint16_t)((c << 8) | (c >> 8)); }
+
+void expandSetColors(uint16_t fg, uint16_t bg) {
+  if (lutValid && fg == lutFg && bg == lutBg) return;
+  uint16_t f = wireOrder(fg), b = wireOrder(bg);
+  for (int m = 0; m < 256; m++) {
+    for (int i = 0; i < 8; i++) expandLut[m][i] = (m >> i) & 1 ? f : b;
+  }
+  lutFg = fg;
+  lutBg = bg;
+  lutValid = true;
+}
+
+uint16_t* expandBits(uint16_t* out, uint32_t mask, int count) {
+  while (count >= 8) {
+    const uint16_t* p = expandLut[mask & 0xFF];
+    out[0] = p[0]; out[1] = p[1]; out[2] = p[2]; out[3] = p[3];
+    out[4] = p[4]; out[5] = p[5]; out[6] = p[6]; out[7] = p[7];
+    out += 8;
+    mask >>= 8;
+    count -= 8;
+  }
+  const uint16_t* p = expandLut[mask & 0xFF];
+  for (int i = 0; i < count; i++) *out++ = p[i];
+  return out;
+}
+
+static inline uint8_t reverseByte(uint8_t b) {
+  b = (b >> 4) | (b << 4);
+  b = ((b & 0xCC) >> 2) | ((b & 0x33) << 2);
+  return ((b & 0xAA) >> 1) | ((b & 0x55) << 1);
+}
+
+// Next 8 bits of an MSB-first stream (unaligned), as an LSB-first mask
+static inline uint8_t streamByte(const uint8_t* bits, uint32_t bit, int count) {
+  const uint8_t* p = bits + (bit >> 3);
+  uint8_t shift = bit & 7;
+  uint8_t b = p[0] << shift;
+  if (shift && count > 8 - shift) b |= p[1] >> (8 - shift);   // Never reads past the last bit
+  return reverseByte(b);
+}
+
+uint16_t* expandBitstream(uint16_t* out, const uint8_t* bits, uint32_t bit, int count, uint8_t scale) {
+  if (scale == 1) {
+    while (count > 0) {
+      int n = count < 8 ? count : 8;
+      out = expandBits(out, streamByte(bits, bit, count), n);
+      bit += n;
+      count -= n;
+    }
+    return out;
+  }
+  // Widen each bit into scale mask bits; the table still writes the pixels
+  uint32_t acc = 0;
+  int accBits = 0;
+  for (int i = 0; i < count; i++, bit++) {
+    bool set = bits[bit >> 3] & (0x80 >> (bit & 7));
+    for (int s = scale; s > 0; ) {
+      int k = s < 8 ? s : 8;
+      if (set) acc |= ((1u << k) - 1) << accBits;
+      accBits += k;
+      s -= k;
+      if (accBits >= 24) {
+        out = expandBits(out, acc, 24);
+        acc >>= 24;
+        accBits -= 24;
+      }
+    }
+  }
+  return expandBits(out, acc, accBits);
+}
@@ -0,0 +1,20 @@
+#ifndef COLOR_EXPAND_H
+#define COLOR_EXPAND_H
+
+#include <Arduino.h>
+
+// --- 1BPP -> RGB565 EXPANSION ---
+// Two-color bitmaps (glyph rows, QR modules, mono blits) turn into panel
+// pixels through a 256-entry table for the current (fg, bg) pair: 8 mask
+// bits in, 8 pixels out, already in SPI byte order. The table is only
+// rebuilt when the pair changes. One table, so render context only.
+void expandSetColors(uint16_t fg, uint16_t bg);
+
+// count pixels from LSB-first mask bits (bit 0 = leftmost); returns the end of out
+uint16_t* expandBits(uint16_t* out, uint32_t mask, int count);
+
+// count pixels from an MSB-first bitstream starting at bit index `bit`,
+// each source bit widened to scale pixels
+uint16_t* expandBitstream(uint16_t* out, const uint8_t* bits, uint32_t bit, int count, uint8_t scale = 1);
+
+#endif
@@ -1,122 +1,611 @@
 #include <qrcode.h> 
 #include <esp_task_wdt.h> 
 #include "DisplayHAL.h"
-
-// --- ST7796 COMMANDS ---
-#define SWRESET     0x01
-#define SLPOUT      0x11
-#define DISPON      0x29
-#define CASET       0x2A
-#define RASET       0x2B
-#define RAMWR       0x2C
-#define MADCTL      0x36
-#define COLMOD      0x3A
-
-// SPI Settings (40MHz)
-SPISettings lcdSettings(40000000, MSBFIRST, SPI_MODE0); 
+#include "LcdBus.h"
+#include "ColorExpand.h"
 
 // --- STATIC QR BUFFER ---
-static uint8_t qrBuffer[3000]; 
+#define QR_AREA_Y       44
+#define QR_AREA_H       240
+static QRImage qrScratch;
+
+// Byte-mode capacity per ECC level (qrcode.h ECC_* order) and version
+static const uint16_t qrByteCapacity[4][QR_MAX_VERSION] = {
+  { 17, 32, 53, 78, 106, 134, 154, 192, 230, 271, 321, 367, 425, 458, 520, 586, 644, 718, 792, 858 },  // Low
+  { 14, 26, 42, 62,  84, 106, 122, 152, 180, 213, 251, 287, 331, 362, 412, 450, 504, 560, 624, 666 },  // Medium
+  { 11, 20, 32, 46,  60,  74,  86, 108, 130, 151, 177, 203, 241, 258, 292, 322, 364, 394, 442, 482 },  // Quartile
+  {  7, 14, 24, 34,  44,  58,  64,  84,  98, 119, 137, 155, 177, 194, 220, 250, 280, 310, 338, 382 }   // High
+};
 
 // --- FONT (5x7) ---
-const uint8_t font[] = {
-  0x3E, 0x51, 0x49, 0x45, 0x3E, 0x00, 0x42, 0x7F, 0x40, 0x00, 0x42, 0x61, 0x51, 0x49, 0x46, 0x21, 0x41, 0x45, 0x4B, 0x31, 
-  0x18, 0x14, 0x12, 0x7F, 0x10, 0x27, 0x45, 0x45, 0x45, 0x39, 0x3C, 0x4A, 0x49, 0x49, 0x30, 0x01, 0x71, 0x09, 0x05, 0x03, 
-  0x36, 0x49, 0x49, 0x49, 0x36, 0x06, 0x49, 0x49, 0x29, 0x1E, 0x7F, 0x09, 0x09, 0x09, 0x7F, 0x7F, 0x49, 0x49, 0x49, 0x36, 
-  0x3E, 0x41, 0x41, 0x41, 0x22, 0x7F, 0x41, 0x41, 0x22, 0x1C, 0x7F, 0x49, 0x49, 0x49, 0x41, 0x7F, 0x09, 0x09, 0x09, 0x01, 
-  0x3E, 0x41, 0x49, 0x49, 0x7A, 0x7F, 0x08, 0x08, 0x08, 0x7F, 0x00, 0x41, 0x7F, 0x41, 0x00, 0x20, 0x40, 0x41, 0x3F, 0x01, 
-  0x7F, 0x08, 0x14, 0x22, 0x41, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x02, 0x0C, 0x02, 0x7F, 0x7F, 0x04, 0x08, 0x10, 0x7F, 
-  0x3E, 0x41, 0x41, 0x41, 0x3E, 0x7F, 0x09, 0x09, 0x09, 0x06, 0x3E, 0x41, 0x51, 0x21, 0x5E, 0x7F, 0x09, 0x19, 0x29, 0x46, 
-  0x46, 0x49, 0x49, 0x49, 0x31, 0x01, 0x01, 0x7F, 0x01, 0x01, 0x3F, 0x40, 0x40, 0x40, 0x3F, 0x1F, 0x20, 0x40, 0x20, 0x1F, 
-  0x3F, 0x40, 0x38, 0x40, 0x3F, 0x63, 0x14, 0x08, 0x14, 0x63, 0x07, 0x08, 0x70, 0x08, 0x07, 0x61, 0x51, 0x49, 0x45, 0x43  
+// Glyph 0 is blank; columns are bit 0 = top row.
+#define GLYPH_DIGITS  1
+#define GLYPH_LETTERS 11
+#define GLYPH_SYMBOLS 37
+static constexpr char fontSymbols[] = "-.:()'\"?,!&$%/";
+#define GLYPH_COUNT   (GLYPH_SYMBOLS + sizeof(fontSymbols) - 1)
+
+static constexpr uint8_t fontGlyphs[GLYPH_COUNT][5] = {
+  {0x00, 0x00, 0x00, 0x00, 0x00},
+  // 0-9
+  {0x3E, 0x51, 0x49, 0x45, 0x3E}, {0x00, 0x42, 0x7F, 0x40, 0x00}, {0x42, 0x61, 0x51, 0x49, 0x46}, {0x21, 0x41, 0x45, 0x4B, 0x31},
+  {0x18, 0x14, 0x12, 0x7F, 0x10}, {0x27, 0x45, 0x45, 0x45, 0x39}, {0x3C, 0x4A, 0x49, 0x49, 0x30}, {0x01, 0x71, 0x09, 0x05, 0x03},
+  {0x36, 0x49, 0x49, 0x49, 0x36}, {0x06, 0x49, 0x49, 0x29, 0x1E},
+  // A-Z
+  {0x7F, 0x09, 0x09, 0x09, 0x7F}, {0x7F, 0x49, 0x49, 0x49, 0x36}, {0x3E, 0x41, 0x41, 0x41, 0x22}, {0x7F, 0x41, 0x41, 0x22, 0x1C},
+  {0x7F, 0x49, 0x49, 0x49, 0x41}, {0x7F, 0x09, 0x09, 0x09, 0x01}, {0x3E, 0x41, 0x49, 0x49, 0x7A}, {0x7F, 0x08, 0x08, 0x08, 0x7F},
+  {0x00, 0x41, 0x7F, 0x41, 0x00}, {0x20, 0x40, 0x41, 0x3F, 0x01}, {0x7F, 0x08, 0x14, 0x22, 0x41}, {0x7F, 0x40, 0x40, 0x40, 0x40},
+  {0x7F, 0x02, 0x0C, 0x02, 0x7F}, {0x7F, 0x04, 0x08, 0x10, 0x7F}, {0x3E, 0x41, 0x41, 0x41, 0x3E}, {0x7F, 0x09, 0x09, 0x09, 0x06},
+  {0x3E, 0x41, 0x51, 0x21, 0x5E}, {0x7F, 0x09, 0x19, 0x29, 0x46}, {0x46, 0x49, 0x49, 0x49, 0x31}, {0x01, 0x01, 0x7F, 0x01, 0x01},
+  {0x3F, 0x40, 0x40, 0x40, 0x3F}, {0x1F, 0x20, 0x40, 0x20, 0x1F}, {0x3F, 0x40, 0x38, 0x40, 0x3F}, {0x63, 0x14, 0x08, 0x14, 0x63},
+  {0x07, 0x08, 0x70, 0x08, 0x07}, {0x61, 0x51, 0x49, 0x45, 0x43},
+  // Symbols, in fontSymbols order
+  {0x08, 0x08, 0x08, 0x08, 0x08}, {0x00, 0x00, 0x40, 0x00, 0x00}, {0x00, 0x00, 0x22, 0x00, 0x00}, {0x00, 0x1C, 0x22, 0x00, 0x00},
+  {0x22, 0x1C, 0x00, 0x00, 0x00}, {0x00, 0x02, 0x00, 0x00, 0x00}, {0x06, 0x00, 0x06, 0x00, 0x00}, {0x20, 0x40, 0x45, 0x48, 0x30},
+  {0x00, 0x50, 0x30, 0x00, 0x00}, {0x00, 0x00, 0x5F, 0x00, 0x00}, {0x36, 0x49, 0x55, 0x22, 0x50}, {0x24, 0x2A, 0x7F, 0x2A, 0x12},
+  {0x23, 0x13, 0x08, 0x64, 0x62}, {0x20, 0x10, 0x08, 0x04, 0x02}
 };
 
+// --- FONT TABLES (built at compile time, live in flash) ---
+template<int... I> struct IndexSeq {};
+template<int N, int... I> struct MakeIndexSeq : MakeIndexSeq<N - 1, N - 1, I...> {};
+template<int... I> struct MakeIndexSeq<0, I...> { typedef IndexSeq<I...> type; };
+
+constexpr int symbolGlyph(char c, int i = 0) {
+  return fontSymbols[i] == 0 ? 0 : (fontSymbols[i] == c ? GLYPH_SYMBOLS + i : symbolGlyph(c, i + 1));
+}
+
+// [FIX] Lowercase shares the uppercase glyphs; unknown chars stay blank (no "Ghost Square")
+constexpr uint8_t asciiGlyph(int c) {
+  return (c >= '0' && c <= '9') ? GLYPH_DIGITS + (c - '0')
+       : (c >= 'A' && c <= 'Z') ? GLYPH_LETTERS + (c - 'A')
+       : (c >= 'a' && c <= 'z') ? GLYPH_LETTERS + (c - 'a')
+       : symbolGlyph((char)c);
+}
+
+struct GlyphMap { uint8_t index[128]; };
+template<int... I>
+constexpr GlyphMap buildGlyphMap(IndexSeq<I...>) { return GlyphMap{ { asciiGlyph(I)... } }; }
+static constexpr GlyphMap glyphMap = buildGlyphMap(MakeIndexSeq<128>::type());
+
+// One glyph row at a given scale: bit px = screen pixel px of the cell (bit 0 = leftmost)
+constexpr uint16_t scaledRow(int g, int row, int size, int px = 0) {
+  return px >= 5 * size ? 0
+       : (uint16_t)((((fontGlyphs[g][px / size] >> row) & 1) << px) | scaledRow(g, row, size, px + 1));
+}
+
+template<int SIZE> struct ScaledFont { uint16_t rows[GLYPH_COUNT * 8]; };
+template<int SIZE, int... I>
+constexpr ScaledFont<SIZE> buildScaledFont(IndexSeq<I...>) { return ScaledFont<SIZE>{ { scaledRow(I / 8, I % 8, SIZE)... } }; }
+
+static constexpr ScaledFont<1> fontSize1 = buildScaledFont<1>(MakeIndexSeq<GLYPH_COUNT * 8>::type());
+static constexpr ScaledFont<2> fontSize2 = buildScaledFont<2>(MakeIndexSeq<GLYPH_COUNT * 8>::type());
+static constexpr ScaledFont<3> fontSize3 = buildScaledFont<3>(MakeIndexSeq<GLYPH_COUNT * 8>::type());
+
+static inline uint8_t glyphIndex(char c) {
+  return (uint8_t)c < 128 ? glyphMap.index[(uint8_t)c] : 0;
+}
+
+// Pre-scaled rows for the sizes the UI uses (NULL = use the column path)
+static const uint16_t* scaledFont(uint8_t size) {
+  if (size == 1) return fontSize1.rows;
+  if (size == 2) return fontSize2.rows;
+  if (size == 3) return fontSize3.rows;
+  return NULL;
+}
+
+// Row mask of glyph g; bold folds in the opaque second pass at +1
+static inline uint32_t glyphRow(const uint16_t* table, uint8_t g, int row, bool bold) {
+  uint32_t m = table[g * 8 + row];
+  return bold ? ((m << 1) | (m & 1)) : m;
+}
+
+// --- PIXEL STREAM (Render side) ---
+// Fills the bus ping-pong buffers; a full buffer goes out over DMA while
+// the next one is being filled.
+static uint8_t* streamBuf = NULL;
+static uint32_t streamLen = 0;
+
+static uint8_t* streamReserve(uint32_t bytes) {
+  if (streamBuf == NULL) { streamBuf = lcdBusPixelBuffer(); streamLen = 0; }
+  if (streamLen + bytes > LCD_BUS_BUFFER_BYTES) {
+    lcdBusQueuePixels(streamLen);
+    streamBuf = lcdBusPixelBuffer();
+    streamLen = 0;
+  }
+  uint8_t* p = streamBuf + streamLen;
+  streamLen += bytes;
+  return p;
+}
+
+static void streamEnd() {
+  if (streamBuf != NULL) lcdBusQueuePixels(streamLen);
+  streamBuf = NULL;
+  streamLen = 0;
+}
+
+static void renderSolid(uint16_t color, uint32_t count) {
+  uint8_t hi = color >> 8, lo = color & 0xFF;
+  while (count > 0) {
+    uint32_t n = count < LCD_BUS_BUFFER_BYTES / 2 ? count : LCD_BUS_BUFFER_BYTES / 2;
+    uint8_t* p = streamReserve(n * 2);
+    for (uint32_t i = 0; i < n; i++) { p[i * 2] = hi; p[i * 2 + 1] = lo; }
+    count -= n;
+  }
+  streamEnd();
+}
+
+static void renderPixels(const uint16_t* pixels, uint32_t count) {
+  while (count > 0) {
+    uint32_t n = count < LCD_BUS_BUFFER_BYTES / 2 ? count : LCD_BUS_BUFFER_BYTES / 2;
+    uint8_t* p = streamReserve(n * 2);
+    for (uint32_t i = 0; i < n; i++) { p[i * 2] = pixels[i] >> 8; p[i * 2 + 1] = pixels[i] & 0xFF; }
+    pixels += n;
+    count -= n;
+  }
+  streamEnd();
+}
+
+static void renderGlyphs(const DisplayCmd& cmd);
+static void renderMono(const DisplayCmd& cmd);
+static void renderCanvas(const DisplayCmd& cmd);
+
+static void renderOne(const DisplayCmd& cmd) {
+  switch (cmd.type) {
+    case CMD_WRITE:
+      if (cmd.write.isData) lcdBusData(cmd.write.data, cmd.write.len);
+      else lcdBusCommand(cmd.write.data[0]);
+      break;
+    case CMD_WINDOW:
+      lcdBusSetWindow(cmd.rect.x, cmd.rect.y, cmd.rect.w, cmd.rect.h);
+      break;
+    case CMD_PUSH_COLOR:
+      renderSolid(cmd.push.color, cmd.push.count);
+      break;
+    case CMD_PIXELS:
+      renderPixels(cmd.pixels.data, cmd.pixels.count);
+      break;
+    case CMD_FILL:
+      lcdBusSetWindow(cmd.rect.x, cmd.rect.y, cmd.rect.w, cmd.rect.h);
+      renderSolid(cmd.rect.color, (uint32_t)cmd.rect.w * cmd.rect.h);
+      break;
+    case CMD_GLYPHS:
+      renderGlyphs(cmd);
+      break;
+    case CMD_CANVAS:
+      renderCanvas(cmd);
+      break;
+    case CMD_MONO:
+      renderMono(cmd);
+      break;
+    case CMD_SYNC:
+      lcdBusWait();
+#if DISPLAY_PIPELINE
+      xTaskNotifyGive((TaskHandle_t)cmd.sync.waiter);
+#endif
+      break;
+  }
+}
+
+static void renderCommand(const DisplayCmd& cmd) {
+#if DISPLAY_STATS
+  if (cmd.type != CMD_SYNC) {
+    DISPLAY_STAT_SCOPE(STAT_RENDER + cmd.type);
+    renderOne(cmd);
+    return;
+  }
+#endif
+  renderOne(cmd);
+}
+
+// --- DISPLAY PIPELINE ---
+#if DISPLAY_PIPELINE
+#define DISPLAY_QUEUE_DEPTH 32
+static QueueHandle_t displayQueue = NULL;
+
+// Owns the bus: pulls commands in order and renders them into the
+// ping-pong buffers, so the CPU fills one while DMA drains the other.
+static void displayTask(void* arg) {
+  DisplayCmd cmd;
+  for (;;) {
+    if (xQueueReceive(displayQueue, &cmd, portMAX_DELAY) == pdTRUE) renderCommand(cmd);
+  }
+}
+
+static void startDisplayTask() {
+  displayQueue = xQueueCreate(DISPLAY_QUEUE_DEPTH, sizeof(DisplayCmd));
+  // loop() runs on core 1; rendering gets the other core
+  xTaskCreatePinnedToCore(displayTask, "display", 4096, NULL, 2, NULL, 0);
+}
+
+static void submitNow(const DisplayCmd& cmd) {
+  if (displayQueue == NULL) { renderCommand(cmd); return; }
+  xQueueSend(displayQueue, &cmd, portMAX_DELAY);
+}
+
+static void flushNow() {
+  if (displayQueue == NULL) { lcdBusWait(); return; }
+  DisplayCmd cmd;
+  cmd.type = CMD_SYNC;
+  cmd.sync.waiter = xTaskGetCurrentTaskHandle();
+  xQueueSend(displayQueue, &cmd, portMAX_DELAY);
+  ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+}
+#else
+static void submitNow(const DisplayCmd& cmd) { renderCommand(cmd); }
+static void flushNow() { lcdBusWait(); }
+#endif
+
+// --- DISPLAY LIST (Overdraw Elimination) ---
+// Commands inside a frame are held back. On replay, touching fills of one
+// color merge into a single window, and fill pixels that a later opaque
+// draw (fill, glyph run, canvas, bitmap) fully repaints are never sent.
+// Only fills are reshaped; everything else goes out as recorded, in order.
+#if DISPLAY_LIST
+#define DL_FRAGMENTS   32    // Pieces one fill may be split into
+#define DL_WINDOW_COST 16    // Bus bytes a split adds (CASET/RASET/RAMWR + transaction)
+
+struct DlRect { int16_t x, y, w, h; };
+static DisplayCmd frameList[DISPLAY_LIST_MAX];
+static bool frameDead[DISPLAY_LIST_MAX];
+static uint8_t frameCount = 0;
+static uint8_t frameDepth = 0;
+
+// Area the command is guaranteed to overwrite completely
+static bool cmdExtent(const DisplayCmd& c, DlRect& r) {
+  switch (c.type) {
+    case CMD_FILL:
+      r.x = c.rect.x; r.y = c.rect.y; r.w = c.rect.w; r.h = c.rect.h;
+      return true;
+    case CMD_GLYPHS:
+      r.x = c.glyphs.x; r.y = c.glyphs.y; r.w = c.glyphs.count * c.glyphs.cellW; r.h = 8 * c.glyphs.size;
+      return true;
+    case CMD_CANVAS:
+      r.x = c.canvas.x; r.y = c.canvas.y; r.w = c.canvas.w; r.h = c.canvas.h;
+      return true;
+    case CMD_MONO:
+      r.x = c.mono.x; r.y = c.mono.y; r.w = c.mono.w * c.mono.scale; r.h = c.mono.h * c.mono.scale;
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Raw window/pixel commands write somewhere we can't see; nothing moves past them
+static bool isRawWrite(const DisplayCmd& c) {
+  return c.type == CMD_WINDOW || c.type == CMD_PUSH_COLOR || c.type == CMD_PIXELS;
+}
+
+static bool rectsOverlap(const DlRect& a, const DlRect& b) {
+  return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+}
+
+static uint32_t overlapArea(const DlRect& a, const DlRect& b) {
+  return (uint32_t)(min(a.x + a.w, b.x + b.w) - max(a.x, b.x)) * (min(a.y + a.h, b.y + b.h) - max(a.y, b.y));
+}
+
+// a minus b as up to 4 disjoint pieces (bands above/below, then left/right)
+static int subtractRect(const DlRect& a, const DlRect& b, DlRect* out) {
+  int n = 0;
+  int top = max(a.y, b.y), bottom = min(a.y + a.h, b.y + b.h);
+  if (b.y > a.y) { DlRect r = { a.x, a.y, a.w, (int16_t)(b.y - a.y) }; out[n++] = r; }
+  if (b.y + b.h < a.y + a.h) { DlRect r = { a.x, (int16_t)(b.y + b.h), a.w, (int16_t)(a.y + a.h - b.y - b.h) }; out[n++] = r; }
+  if (b.x > a.x) { DlRect r = { a.x, (int16_t)top, (int16_t)(b.x - a.x), (int16_t)(bottom - top) }; out[n++] = r; }
+  if (b.x + b.w < a.x + a.w) { DlRect r = { (int16_t)(b.x + b.w), (int16_t)top, (int16_t)(a.x + a.w - b.x - b.w), (int16_t)(bottom - top) }; out[n++] = r; }
+  return n;
+}
+
+static bool mergeAdjacent(const DlRect& a, const DlRect& b, DlRect& out) {
+  if (a.x == b.x && a.w == b.w && (a.y + a.h == b.y || b.y + b.h == a.y)) {
+    out.x = a.x; out.w = a.w; out.y = min(a.y, b.y); out.h = a.h + b.h;
+    return true;
+  }
+  if (a.y == b.y && a.h == b.h && (a.x + a.w == b.x || b.x + b.w == a.x)) {
+    out.y = a.y; out.h = a.h; out.x = min(a.x, b.x); out.w = a.w + b.w;
+    return true;
+  }
+  return false;
+}
+
+// Pulls a later fill up into an earlier one when nothing in between touches it
+static void mergeFills() {
+  for (int i = 0; i < frameCount; i++) {
+    DisplayCmd& a = frameList[i];
+    if (frameDead[i] || a.type != CMD_FILL) continue;
+    for (int j = i + 1; j < frameCount; j++) {
+      const DisplayCmd& b = frameList[j];
+      if (frameDead[j]) continue;
+      if (isRawWrite(b)) break;
+      DlRect ra, rb, merged;
+      cmdExtent(a, ra);
+      if (b.type != CMD_FILL || b.rect.color != a.rect.color || !cmdExtent(b, rb) || !mergeAdjacent(ra, rb, merged)) continue;
+      bool clear = true;
+      for (int k = i + 1; k < j && clear; k++) {
+        DlRect rk;
+        if (!frameDead[k] && cmdExtent(frameList[k], rk) && rectsOverlap(rk, rb)) clear = false;
+      }
+      if (!clear) continue;
+      a.rect.x = merged.x; a.rect.y = merged.y; a.rect.w = merged.w; a.rect.h = merged.h;
+      frameDead[j] = true;
+      j = i;   // The rect grew; rescan
+    }
+  }
+}
+
+// Sends what is left of fill i once everything drawn after it is subtracted
+static void replayFill(int i) {
+  DlRect frags[DL_FRAGMENTS];
+  int n = 1;
+  cmdExtent(frameList[i], frags[0]);
+  for (int j = i + 1; j < frameCount && n > 0; j++) {
+    DlRect occ;
+    if (frameDead[j] || !cmdExtent(frameList[j], occ)) continue;
+    DlRect next[DL_FRAGMENTS];
+    int m = 0;
+    uint32_t removed = 0;
+    bool fits = true;
+    for (int f = 0; f < n && fits; f++) {
+      DlRect pieces[4];
+      int k = 1;
+      pieces[0] = frags[f];
+      if (rectsOverlap(frags[f], occ)) {
+        k = subtractRect(frags[f], occ, pieces);
+        removed += overlapArea(frags[f], occ);
+      }
+      if (m + k > DL_FRAGMENTS) { fits = false; break; }
+      for (int p = 0; p < k; p++) next[m++] = pieces[p];
+    }
+    // Splitting a small overlap costs more in windows than it saves in pixels
+    if (!fits || (m > n && (uint32_t)(m - n) * DL_WINDOW_COST >= removed * 2)) continue;
+    memcpy(frags, next, m * sizeof(DlRect));
+    n = m;
+  }
+  DisplayCmd c = frameList[i];
+  for (int f = 0; f < n; f++) {
+    c.rect.x = frags[f].x; c.rect.y = frags[f].y; c.rect.w = frags[f].w; c.rect.h = frags[f].h;
+    submitNow(c);
+  }
+}
+
+static void replayFrame() {
+  mergeFills();
+  for (int i = 0; i < frameCount; i++) {
+    if (frameDead[i]) continue;
+    if (frameList[i].type == CMD_FILL) replayFill(i);
+    else submitNow(frameList[i]);
+  }
+  frameCount = 0;
+}
+
+void displayBeginFrame() { frameDepth++; }
+
+void displayEndFrame() {
+  if (frameDepth == 0) return;
+  if (--frameDepth == 0 && frameCount > 0) replayFrame();
+}
+
+void displaySubmit(const DisplayCmd& cmd) {
+  if (frameDepth == 0) { submitNow(cmd); return; }
+  if (frameCount == DISPLAY_LIST_MAX) replayFrame();   // Full: optimize what we have so far
+  frameDead[frameCount] = false;
+  frameList[frameCount++] = cmd;
+}
+
+void displayFlush() {
+  if (frameCount > 0) replayFrame();
+  flushNow();
+}
+#else
+void displayBeginFrame() {}
+void displayEndFrame() {}
+void displaySubmit(const DisplayCmd& cmd) { submitNow(cmd); }
+void displayFlush() { flushNow(); }
+#endif
+
+// --- SYNCHRONOUS WRAPPERS ---
+uint32_t getSpiBytesSent() { return lcdBusBytesSent(); }
+
 void writeCmd(uint8_t cmd) {
-  SPI.beginTransaction(lcdSettings);
-  digitalWrite(LCD_DC, LOW);
-  digitalWrite(LCD_CS, LOW);
-  SPI.transfer(cmd);
-  digitalWrite(LCD_CS, HIGH); SPI.endTransaction();
+  DisplayCmd c;
+  c.type = CMD_WRITE;
+  c.write.isData = false; c.write.len = 1; c.write.data[0] = cmd;
+  displaySubmit(c);
 }
 
 void writeData(uint8_t data) {
-  SPI.beginTransaction(lcdSettings);
-  digitalWrite(LCD_DC, HIGH); digitalWrite(LCD_CS, LOW);
-  SPI.transfer(data);
-  digitalWrite(LCD_CS, HIGH); SPI.endTransaction();
+  DisplayCmd c;
+  c.type = CMD_WRITE;
+  c.write.isData = true; c.write.len = 1; c.write.data[0] = data;
+  displaySubmit(c);
 }
 
 void writeData16(uint16_t data) {
-  SPI.beginTransaction(lcdSettings);
-  digitalWrite(LCD_DC, HIGH); digitalWrite(LCD_CS, LOW);
-  SPI.transfer(data >> 8); SPI.transfer(data & 0xFF);
-  digitalWrite(LCD_CS, HIGH); SPI.endTransaction();
+  DisplayCmd c;
+  c.type = CMD_WRITE;
+  c.write.isData = true; c.write.len = 2;
+  c.write.data[0] = data >> 8; c.write.data[1] = data & 0xFF;
+  displaySubmit(c);
 }
 
 void setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
-  writeCmd(CASET); writeData16(x); writeData16(x + w - 1);
-  writeCmd(RASET); writeData16(y); writeData16(y + h - 1);
-  writeCmd(RAMWR);
+  DisplayCmd c;
+  c.type = CMD_WINDOW;
+  c.rect.x = x; c.rect.y = y; c.rect.w = w; c.rect.h = h;
+  displaySubmit(c);
+}
+
+void pushColor(uint16_t color, uint32_t count) {
+  if (count == 0) return;
+  DisplayCmd c;
+  c.type = CMD_PUSH_COLOR;
+  c.push.color = color; c.push.count = count;
+  displaySubmit(c);
+}
+
+void writePixels(const uint16_t* pixels, uint32_t count) {
+  if (count == 0) return;
+  DisplayCmd c;
+  c.type = CMD_PIXELS;
+  c.pixels.data = pixels; c.pixels.count = count;
+  displaySubmit(c);
+  displayFlush(); // Caller owns the pixel memory
 }
 
 void fillRect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color) {
+  DISPLAY_STAT_SCOPE(STAT_FILL_RECT);
   if((x + w) > 480 || (y + h) > 320) return;
-  setAddrWindow(x, y, w, h);
-  SPI.beginTransaction(lcdSettings);
-  digitalWrite(LCD_DC, HIGH); digitalWrite(LCD_CS, LOW);
-  for(uint32_t i = 0; i < (uint32_t)w * h; i++) {
-    SPI.transfer(color >> 8);
-    SPI.transfer(color & 0xFF);
+  if (w == 0 || h == 0) return;
+  DisplayCmd c;
+  c.type = CMD_FILL;
+  c.rect.x = x; c.rect.y = y; c.rect.w = w; c.rect.h = h; c.rect.color = color;
+  displaySubmit(c);
+}
+
+void benchmarkFill() {
+  struct { const char* label; uint16_t w, h; } cases[] = {
+    { "Full screen 480x320", 480, 320 },
+    { "Story row   480x100", 480, 100 }
+  };
+  Serial.println("[DisplayHAL] Fill benchmark (submit -> on glass):");
+  for (int c = 0; c < 2; c++) {
+    esp_task_wdt_reset();
+    displayFlush();
+    unsigned long t0 = micros();
+    fillRect(0, 0, cases[c].w, cases[c].h, BLACK);
+    unsigned long submitUs = micros() - t0;
+    displayFlush();
+    unsigned long totalUs = micros() - t0;
+    Serial.print("[DisplayHAL]   "); Serial.print(cases[c].label);
+    Serial.print(": caller "); Serial.print(submitUs); Serial.print(" us, done ");
+    Serial.print(totalUs); Serial.println(" us");
   }
-  digitalWrite(LCD_CS, HIGH); SPI.endTransaction();
 }
 
-void drawChar(int x, int y, char c, uint16_t color, uint16_t bg, uint8_t size) {
-  // [FIX] Manual Case Conversion (Safer than toupper)
-  if (c >= 'a' && c <= 'z') c -= 32;
+// --- DISPLAY STATS ---
+#if DISPLAY_STATS
+// Upper bucket edges in microseconds; the last bucket takes the rest
+static const uint32_t statBucketUs[] = { 250, 1000, 2000, 5000, 10000, 20000, 50000 };
+#define STAT_BUCKETS (sizeof(statBucketUs) / sizeof(statBucketUs[0]) + 1)
+static const char* const statNames[STAT_PROBE_COUNT] = {
+  "fillRect", "drawChar", "drawText", "drawQRCode", "drawSignalBars", "row frame", "header frame",
+  "render write", "render window", "render pushColor", "render pixels",
+  "render fill", "render glyphs", "render canvas", "render mono"
+};
+struct DisplayStat {
+  uint32_t calls;
+  uint32_t totalUs;
+  uint32_t maxUs;
+  uint32_t hist[STAT_BUCKETS];
+};
+static DisplayStat displayStats[STAT_PROBE_COUNT];
+static uint32_t statBaseBytes = 0, statBaseTx = 0, statBaseWindows = 0;
+static unsigned long statSince = 0;
 
-  uint8_t charBuffer[5] = {0,0,0,0,0};
-  const uint8_t* ptr = charBuffer;
-  int idx = -1;
-  
-  if (c >= '0' && c <= '9') idx = (c - '0') * 5;
-  else if (c >= 'A' && c <= 'Z') idx = 50 + (c - 'A') * 5;
-  
-  if (idx != -1) {
-      ptr = &font[idx];
-  } else {
-    // Symbol Mapping
-    if (c == '-') { charBuffer[0]=0x08; charBuffer[1]=0x08; charBuffer[2]=0x08; charBuffer[3]=0x08; charBuffer[4]=0x08; }
-    else if (c == '.') { charBuffer[2]=0x40; } 
-    else if (c == ':') { charBuffer[2]=0x22; } 
-    else if (c == '(') { charBuffer[1]=0x1C; charBuffer[2]=0x22; }
-    else if (c == ')') { charBuffer[0]=0x22; charBuffer[1]=0x1C; }
-    else if (c == '\'') { charBuffer[1]=0x02; } 
-    else if (c == '"')  { charBuffer[0]=0x06; charBuffer[2]=0x06; } 
-    else if (c == '?')  { charBuffer[0]=0x20; charBuffer[1]=0x40; charBuffer[2]=0x45; charBuffer[3]=0x48; charBuffer[4]=0x30; } 
-    else {
-        // [CRITICAL FIX] Unknown Char -> Empty Space (was Block)
-        // This hides the "Ghost Square" if a bad char sneaks in
-        charBuffer[0]=0x00; charBuffer[1]=0x00; charBuffer[2]=0x00; charBuffer[3]=0x00; charBuffer[4]=0x00; 
+void recordDisplayStat(uint8_t probe, uint32_t us) {
+  DisplayStat& s = displayStats[probe];
+  s.calls++;
+  s.totalUs += us;
+  if (us > s.maxUs) s.maxUs = us;
+  uint8_t b = 0;
+  while (b < STAT_BUCKETS - 1 && us >= statBucketUs[b]) b++;
+  s.hist[b]++;
+}
+
+void resetDisplayStats() {
+  memset(displayStats, 0, sizeof(displayStats));
+  statBaseBytes = lcdBusBytesSent();
+  lcdBusStats(statBaseTx, statBaseWindows);
+  statSince = millis();
+}
+
+void printDisplayStats() {
+  uint32_t tx, windows;
+  lcdBusStats(tx, windows);
+  unsigned long ms = millis() - statSince;
+  Serial.print("[DisplayHAL] Stats over "); Serial.print(ms / 1000); Serial.println(" s:");
+  Serial.print("[DisplayHAL]   SPI bytes: "); Serial.print(lcdBusBytesSent() - statBaseBytes);
+  Serial.print(" | transactions: "); Serial.print(tx - statBaseTx);
+  Serial.print(" | windows: "); Serial.println(windows - statBaseWindows);
+
+  for (int p = 0; p < STAT_PROBE_COUNT; p++) {
+    const DisplayStat& s = displayStats[p];
+    if (s.calls == 0) continue;
+    Serial.print("[DisplayHAL]   "); Serial.print(statNames[p]);
+    Serial.print(": calls "); Serial.print(s.calls);
+    Serial.print(" | total "); Serial.print(s.totalUs);
+    Serial.print(" us | avg "); Serial.print(s.totalUs / s.calls);
+    Serial.print(" us | max "); Serial.print(s.maxUs); Serial.println(" us");
+    Serial.print("[DisplayHAL]     hist");
+    for (uint8_t b = 0; b < STAT_BUCKETS; b++) {
+      Serial.print(b < STAT_BUCKETS - 1 ? " <" : " >=");
+      Serial.print(statBucketUs[b < STAT_BUCKETS - 1 ? b : b - 1]);
+      Serial.print(":"); Serial.print(s.hist[b]);
     }
+    Serial.println();
   }
-  
+}
+#endif
+
+// Per-pixel path for glyphs that cross the screen edge (each block clips alone)
+static void drawCharClipped(int x, int y, const uint8_t* ptr, uint16_t color, uint16_t bg, uint8_t size) {
   for (int i = 0; i < 5; i++) {
     uint8_t line = ptr[i];
     for (int j = 0; j < 8; j++) {
-      if (line & 0x1) {
-        if (size == 1) fillRect(x + i, y + j, 1, 1, color);
-        else fillRect(x + i * size, y + j * size, size, size, color);
-      } else {
-        if (size == 1) fillRect(x + i, y + j, 1, 1, bg);
-        else fillRect(x + i * size, y + j * size, size, size, bg);
-      }
+      fillRect(x + i * size, y + j * size, size, size, (line & 0x1) ? color : bg);
       line >>= 1;
     }
   }
 }
 
+// Streams a run of glyph cells on one text line through a single address window.
+// Each cell is cellW wide; the pre-scaled row masks leave the gap as background.
+// Bold matches the old opaque double draw: the second pass at +1 wins.
+static void renderGlyphs(const DisplayCmd& cmd) {
+  uint8_t glyphs[DISPLAY_TEXT_RUN_MAX];
+  int count = cmd.glyphs.count;
+  int cellW = cmd.glyphs.cellW, size = cmd.glyphs.size;
+  bool bold = cmd.glyphs.bold;
+  uint16_t color = cmd.glyphs.color, bg = cmd.glyphs.bg;
+  const uint16_t* table = scaledFont(size);
+  for (int n = 0; n < count; n++) glyphs[n] = glyphIndex(cmd.glyphs.text[n]);
+
+  uint32_t lineBytes = (uint32_t)count * cellW * 2;
+  lcdBusSetWindow(cmd.glyphs.x, cmd.glyphs.y, count * cellW, 8 * size);
+  expandSetColors(color, bg);
+  for (int j = 0; j < 8; j++) {
+    uint8_t* line = streamReserve(lineBytes);
+    uint16_t* out = (uint16_t*)line;
+    for (int n = 0; n < count; n++) out = expandBits(out, glyphRow(table, glyphs[n], j, bold), cellW);
+    // Scaled rows repeat; the source stays valid while its buffer drains
+    for (int r = 1; r < size; r++) memcpy(streamReserve(lineBytes), line, lineBytes);
+  }
+  streamEnd();
+}
+
+static void submitGlyphRun(int x, int y, const char* str, int count, int cellW,
+                           uint16_t color, uint16_t bg, uint8_t size, bool bold) {
+  DisplayCmd c;
+  c.type = CMD_GLYPHS;
+  c.glyphs.x = x; c.glyphs.y = y;
+  c.glyphs.color = color; c.glyphs.bg = bg;
+  c.glyphs.size = size; c.glyphs.bold = bold;
+  c.glyphs.cellW = cellW;
+  c.glyphs.count = count;
+  memcpy(c.glyphs.text, str, count);
+  displaySubmit(c);
+}
+
+void drawChar(int x, int y, char c, uint16_t color, uint16_t bg, uint8_t size) {
+  DISPLAY_STAT_SCOPE(STAT_DRAW_CHAR);
+  if (x < 0 || y < 0 || x + 5 * size > 480 || y + 8 * size > 320 || !scaledFont(size)) {
+    drawCharClipped(x, y, fontGlyphs[glyphIndex(c)], color, bg, size);
+    return;
+  }
+  submitGlyphRun(x, y, &c, 1, 5 * size, color, bg, size, false);
+}
+
 void drawText(int x, int y, int w, const char* str, uint16_t color, uint16_t bg, uint8_t size, bool bold) {
+  DISPLAY_STAT_SCOPE(STAT_DRAW_TEXT);
   int curX = x;
   int curY = y;
   int charWidth = 6 * size; 
@@ -131,61 +620,327 @@ void drawText(int x, int y, int w, const char* str, uint16_t color, uint16_t bg,
     if (curX + charWidth > x + w) {
       curX = x; curY += lineHeight + 4;
     }
-    fillRect(curX, curY, charWidth, lineHeight, bg);
-    if (c != ' ') {
-      drawChar(curX, curY, c, color, bg, size);
-      if (bold) drawChar(curX + 1, curY, c, color, bg, size);
+
+    // Gather every glyph that lands on this line before the next wrap
+    int runLen = 0;
+    int runX = curX;
+    while (p[runLen] && p[runLen] != '\n' && runX + charWidth <= x + w) {
+      runLen++;
+      runX += charWidth;
+    }
+    if (runLen == 0) runLen = 1; // Cell wider than the box: one glyph per line
+
+    if (curX >= 0 && curY >= 0 && curX + runLen * charWidth <= 480 && curY + lineHeight <= 320 && scaledFont(size)) {
+      submitGlyphRun(curX, curY, p, runLen, charWidth, color, bg, size, bold);
+      curX += runLen * charWidth;
+      p += runLen;
+      continue;
+    }
+
+    // Off-screen edge (or unscaled size): legacy per-cell path keeps the exact clipping behaviour
+    for (int n = 0; n < runLen; n++) {
+      fillRect(curX, curY, charWidth, lineHeight, bg);
+      if (*p != ' ') {
+        const uint8_t* cols = fontGlyphs[glyphIndex(*p)];
+        drawCharClipped(curX, curY, cols, color, bg, size);
+        if (bold) drawCharClipped(curX + 1, curY, cols, color, bg, size);
+      }
+      curX += charWidth;
+      p++;
+    }
+  }
+}
+
+// --- MONO BITMAP ---
+// Expands one bitmap row into a scaled scanline, then repeats it scale times
+static void renderMono(const DisplayCmd& cmd) {
+  uint16_t w = cmd.mono.w, h = cmd.mono.h, scale = cmd.mono.scale;
+  uint32_t lineBytes = (uint32_t)w * scale * 2;
+  lcdBusSetWindow(cmd.mono.x, cmd.mono.y, w * scale, h * scale);
+  expandSetColors(cmd.mono.color, cmd.mono.bg);
+  for (uint16_t row = 0; row < h; row++) {
+    uint8_t* line = streamReserve(lineBytes);
+    expandBitstream((uint16_t*)line, cmd.mono.bits, (uint32_t)row * w, w, scale);
+    for (uint16_t r = 1; r < scale; r++) memcpy(streamReserve(lineBytes), line, lineBytes);
+  }
+  streamEnd();
+}
+
+void drawMonoBitmap(uint16_t x, uint16_t y, const uint8_t* bits, uint16_t w, uint16_t h, uint8_t scale, uint16_t color, uint16_t bg) {
+  if (scale == 0 || w == 0 || h == 0 || x + w * scale > 480 || y + h * scale > 320) return;
+  DisplayCmd c;
+  c.type = CMD_MONO;
+  c.mono.bits = bits;
+  c.mono.x = x; c.mono.y = y; c.mono.w = w; c.mono.h = h;
+  c.mono.scale = scale;
+  c.mono.color = color; c.mono.bg = bg;
+  displaySubmit(c);
+  displayFlush(); // Bits belong to the caller
+}
+
+// --- MONO CANVAS ---
+static inline void monoSetBit(MonoCanvas& mc, int x, int y) {
+  if (x < 0 || y < 0 || x >= mc.width || y >= mc.height) return;
+  mc.bits[y * mc.stride + (x >> 3)] |= 0x80 >> (x & 7);
+}
+
+void monoDrawLine(MonoCanvas& mc, int x, int y, const char* str, int len, uint8_t size) {
+  const uint16_t* table = scaledFont(size);
+  for (int i = 0; i < len; i++, x += 6 * size) {
+    uint8_t g = glyphIndex(str[i]);
+    if (g == 0) continue;
+    for (int j = 0; j < 8; j++) {
+      uint32_t mask = table ? glyphRow(table, g, j, false) : 0;
+      for (int px = 0; px < 5 * size; px++) {
+        bool on = table ? ((mask >> px) & 1) : ((fontGlyphs[g][px / size] >> j) & 1);
+        if (!on) continue;
+        for (int dy = 0; dy < size; dy++) monoSetBit(mc, x + px, y + j * size + dy);
+      }
+    }
+  }
+}
+
+// --- PALETTE CANVAS ---
+static inline void canvasSetPixel(PaletteCanvas& cv, int x, int y, uint8_t idx) {
+  if (x < 0 || y < 0 || x >= cv.width || y >= cv.height) return;
+  uint32_t i = (uint32_t)y * cv.width + x;
+  uint8_t shift = 6 - 2 * (i & 3);
+  cv.pixels[i >> 2] = (cv.pixels[i >> 2] & ~(0x03 << shift)) | ((idx & 0x03) << shift);
+}
+
+void canvasFillRect(PaletteCanvas& cv, int x, int y, int w, int h, uint8_t colorIdx) {
+  if (x < 0) { w += x; x = 0; }
+  if (y < 0) { h += y; y = 0; }
+  if (x + w > cv.width) w = cv.width - x;
+  if (y + h > cv.height) h = cv.height - y;
+  if (w <= 0 || h <= 0) return;
+
+  uint8_t packed = (colorIdx & 0x03) * 0x55; // Same index in all four slots
+  for (int row = y; row < y + h; row++) {
+    int px = x, end = x + w;
+    while (px < end && (px & 3)) canvasSetPixel(cv, px++, row, colorIdx);
+    uint32_t base = ((uint32_t)row * cv.width) >> 2;
+    while (end - px >= 4) { cv.pixels[base + (px >> 2)] = packed; px += 4; }
+    while (px < end) canvasSetPixel(cv, px++, row, colorIdx);
+  }
+}
+
+static void canvasDrawColumns(PaletteCanvas& cv, int x, int y, const uint8_t* cols, uint8_t colorIdx, uint8_t bgIdx, uint8_t size) {
+  for (int i = 0; i < 5; i++) {
+    uint8_t line = cols[i];
+    for (int j = 0; j < 8; j++) {
+      uint8_t idx = (line & 0x1) ? colorIdx : bgIdx;
+      for (int dy = 0; dy < size; dy++)
+        for (int dx = 0; dx < size; dx++) canvasSetPixel(cv, x + i * size + dx, y + j * size + dy, idx);
+      line >>= 1;
+    }
+  }
+}
+
+static void canvasDrawGlyph(PaletteCanvas& cv, int x, int y, uint8_t g, uint8_t colorIdx, uint8_t bgIdx, uint8_t size, bool bold) {
+  const uint16_t* table = scaledFont(size);
+  if (!table) {
+    canvasDrawColumns(cv, x, y, fontGlyphs[g], colorIdx, bgIdx, size);
+    if (bold) canvasDrawColumns(cv, x + 1, y, fontGlyphs[g], colorIdx, bgIdx, size);
+    return;
+  }
+  int glyphW = 5 * size + (bold ? 1 : 0);
+  for (int j = 0; j < 8; j++) {
+    uint32_t mask = glyphRow(table, g, j, bold);
+    for (int px = 0; px < glyphW; px++) {
+      uint8_t idx = (mask & 1) ? colorIdx : bgIdx;
+      for (int dy = 0; dy < size; dy++) canvasSetPixel(cv, x + px, y + j * size + dy, idx);
+      mask >>= 1;
     }
+  }
+}
+
+// One opaque text cell (6x8 at size 1)
+static void canvasDrawCell(PaletteCanvas& cv, int x, int y, char c, uint8_t colorIdx, uint8_t bgIdx, uint8_t size, bool bold) {
+  int charWidth = 6 * size;
+  // Cells wholly outside a narrow canvas (scroll strips) cost nothing
+  if (x >= cv.width || x + charWidth <= 0) return;
+  canvasFillRect(cv, x, y, charWidth, 8 * size, bgIdx);
+  if (c != ' ') canvasDrawGlyph(cv, x, y, glyphIndex(c), colorIdx, bgIdx, size, bold);
+}
+
+// 4 mono pixels (MSB = leftmost) -> 2bpp mask of the same 4 pixels
+static const uint8_t nibbleSpread[16] = {
+  0x00, 0x03, 0x0C, 0x0F, 0x30, 0x33, 0x3C, 0x3F, 0xC0, 0xC3, 0xCC, 0xCF, 0xF0, 0xF3, 0xFC, 0xFF
+};
+
+void canvasBlitMono(PaletteCanvas& cv, int x, int y, const MonoCanvas& mc, uint8_t colorIdx, uint8_t bgIdx) {
+  int x0 = max(0, -x), x1 = min((int)mc.width, (int)cv.width - x);
+  int y0 = max(0, -y), y1 = min((int)mc.height, (int)cv.height - y);
+  if (x0 >= x1 || y0 >= y1) return;
+
+  uint8_t fg = (colorIdx & 0x03) * 0x55, bg = (bgIdx & 0x03) * 0x55;
+  bool packed = ((x | x0 | x1) & 3) == 0;   // Whole canvas bytes line up with source nibbles
+  for (int row = y0; row < y1; row++) {
+    const uint8_t* src = mc.bits + row * mc.stride;
+    if (packed) {
+      uint8_t* dst = cv.pixels + (((uint32_t)(y + row) * cv.width + x + x0) >> 2);
+      for (int sx = x0; sx < x1; sx += 4) {
+        uint8_t m = nibbleSpread[(src[sx >> 3] >> (4 - (sx & 4))) & 0x0F];
+        *dst++ = (m & fg) | (~m & bg);
+      }
+    } else {
+      for (int sx = x0; sx < x1; sx++) {
+        canvasSetPixel(cv, x + sx, y + row, (src[sx >> 3] & (0x80 >> (sx & 7))) ? colorIdx : bgIdx);
+      }
+    }
+  }
+}
+
+void canvasDrawText(PaletteCanvas& cv, int x, int y, int w, const char* str, uint8_t colorIdx, uint8_t bgIdx, uint8_t size, bool bold) {
+  // Same layout rules as drawText, clipped to the canvas instead of the screen
+  int curX = x;
+  int curY = y;
+  int charWidth = 6 * size; 
+  int lineHeight = 8 * size;
+  const char* p = str;
+
+  while (*p) {
+    char c = *p;
+    if (c == '\n') {
+      curX = x; curY += lineHeight + 4; p++; continue;
+    }
+    if (curX + charWidth > x + w) {
+      curX = x; curY += lineHeight + 4;
+    }
+    canvasDrawCell(cv, curX, curY, c, colorIdx, bgIdx, size, bold);
     curX += charWidth;
     p++;
   }
 }
 
+void canvasDrawLine(PaletteCanvas& cv, int x, int y, const char* str, int len, uint8_t colorIdx, uint8_t bgIdx, uint8_t size, bool bold) {
+  for (int i = 0; i < len; i++) {
+    canvasDrawCell(cv, x, y, str[i], colorIdx, bgIdx, size, bold);
+    x += 6 * size;
+  }
+}
+
+static void renderCanvas(const DisplayCmd& cmd) {
+  uint16_t w = cmd.canvas.w, h = cmd.canvas.h;
+  lcdBusSetWindow(cmd.canvas.x, cmd.canvas.y, w, h);
+  for (int row = 0; row < h; row++) {
+    const uint8_t* src = cmd.canvas.pixels + (uint32_t)row * cmd.canvas.stride;
+    uint8_t* out = streamReserve((uint32_t)w * 2);
+    for (int px = 0; px < w; px += 4) {
+      uint8_t quad = *src++;
+      for (int k = 0; k < 4; k++) {
+        uint16_t c = cmd.canvas.palette[(quad >> 6) & 0x03];
+        *out++ = c >> 8;
+        *out++ = c & 0xFF;
+        quad <<= 2;
+      }
+    }
+  }
+  streamEnd();
+}
+
+void pushCanvasRect(const PaletteCanvas& cv, uint16_t srcX, uint16_t srcY, uint16_t w, uint16_t h, uint16_t x, uint16_t y) {
+  if ((srcX & 3) || (w & 3) || w == 0 || h == 0) return;
+  if (srcX + w > cv.width || srcY + h > cv.height) return;
+  if ((x + w) > 480 || (y + h) > 320) return;
+  DisplayCmd c;
+  c.type = CMD_CANVAS;
+  c.canvas.pixels = cv.pixels + (((uint32_t)srcY * cv.width + srcX) >> 2);
+  memcpy(c.canvas.palette, cv.palette, sizeof(c.canvas.palette));
+  c.canvas.stride = cv.width / 4;
+  c.canvas.x = x; c.canvas.y = y; c.canvas.w = w; c.canvas.h = h;
+  displaySubmit(c);
+}
+
+void pushCanvas(const PaletteCanvas& cv, uint16_t x, uint16_t y) {
+  pushCanvasRect(cv, 0, 0, cv.width, cv.height, x, y);
+  displayFlush(); // Caller may recompose the canvas as soon as this returns
+}
+
+bool encodeQRCode(const char* url, QRImage& out) {
+    if (url == NULL || strlen(url) < 10) return false;
+
+    // Smallest version that holds the URL, then the strongest ECC that still fits
+    int len = strlen(url);
+    int version = 1;
+    while (version <= QR_MAX_VERSION && qrByteCapacity[ECC_LOW][version - 1] < len) version++;
+    if (version > QR_MAX_VERSION) return false;
+    uint8_t ecc = ECC_HIGH;
+    while (ecc > ECC_LOW && qrByteCapacity[ecc][version - 1] < len) ecc--;
+
+    QRCode qrcode;
+    qrcode_initText(&qrcode, out.modules, version, ecc, url);
+    out.version = version;
+    out.ecc = ecc;
+    out.size = qrcode.size;
+    return true;
+}
+
+void drawQRImage(const QRImage& img, const char* label) {
+    esp_task_wdt_reset();
+    displayBeginFrame();   // The white page only goes out around the code and captions
+    fillRect(0, 0, 480, 320, WHITE);
+    
+    // Largest whole-module scale for the 480x240 area between the captions
+    int scale = QR_AREA_H / img.size;
+    int size = img.size * scale;
+    int startX = (480 - size) / 2;
+    int startY = QR_AREA_Y + (QR_AREA_H - size) / 2;
+
+    // Module grid is already a packed 1bpp bitstream: one window, one pass
+    drawMonoBitmap(startX, startY, img.modules, img.size, img.size, scale, BLACK, WHITE);
+
+    drawText(10, 10, 460, "LONG PRESS TO EXIT", BLACK, WHITE, 2);
+    if (label != NULL) drawText(10, 285, 460, label, BLACK, WHITE, 2);
+    displayEndFrame();
+
+    #ifdef DEBUG_MODE
+    if (DEBUG_MODE) {
+      Serial.print("[DisplayHAL] QR v"); Serial.print(img.version);
+      Serial.print(" ecc "); Serial.print(img.ecc);
+      Serial.print(" scale "); Serial.println(scale);
+    }
+    #endif
+}
+
 void drawQRCode(const char* url, const char* label) {
+    DISPLAY_STAT_SCOPE(STAT_DRAW_QR);
     esp_task_wdt_reset();
 
     if (url == NULL || strlen(url) < 10) {
+         displayBeginFrame();
          fillRect(0, 0, 480, 320, WHITE);
          drawText(10, 150, 460, "ERROR: LINK INVALID", RED, WHITE, 2);
          drawText(10, 180, 460, "NO URL FOUND", RED, WHITE, 2);
          drawText(10, 285, 460, "TAP TO EXIT", BLACK, WHITE, 2);
+         displayEndFrame();
          return;
     }
 
-    int version = 15; 
-    
-    if (strlen(url) > 1200) {
+    if (!encodeQRCode(url, qrScratch)) {
+         displayBeginFrame();
          fillRect(0, 0, 480, 320, WHITE);
          drawText(10, 150, 460, "ERROR: URL TOO LONG", RED, WHITE, 2);
          drawText(10, 285, 460, "TAP TO EXIT", BLACK, WHITE, 2);
+         displayEndFrame();
          return;
     }
+    drawQRImage(qrScratch, label);
+}
 
-    QRCode qrcode;
-    qrcode_initText(&qrcode, qrBuffer, version, 0, url);
-    
-    fillRect(0, 0, 480, 320, WHITE);
-    
-    int scale = 3; 
-    int size = qrcode.size * scale;
-    int startX = (480 - size) / 2;
-    int startY = 44; 
-    
-    for (uint8_t y = 0; y < qrcode.size; y++) {
-        esp_task_wdt_reset(); 
-        yield();
-        for (uint8_t x = 0; x < qrcode.size; x++) {
-            if (qrcode_getModule(&qrcode, x, y)) {
-                fillRect(startX + (x * scale), startY + (y * scale), scale, scale, BLACK);
-            }
-        }
-    }
+void setScrollArea(uint16_t fixedLeft, uint16_t scrollWidth, uint16_t fixedRight) {
+  writeCmd(VSCRDEF);
+  writeData16(fixedLeft); writeData16(scrollWidth); writeData16(fixedRight);
+}
 
-    drawText(10, 10, 460, "LONG PRESS TO EXIT", BLACK, WHITE, 2);
-    if (label != NULL) drawText(10, 285, 460, label, BLACK, WHITE, 2);
+void setScrollOffset(uint16_t x) {
+  writeCmd(VSCRSADD);
+  writeData16(x);
 }
 
 void drawSignalBars(int x, int y, int rssi, bool force) {
+  DISPLAY_STAT_SCOPE(STAT_SIGNAL_BARS);
   int activeBars = 0;
   if (rssi > -50) activeBars = 5;       
   else if (rssi > -60) activeBars = 4;  
@@ -195,17 +950,23 @@ void drawSignalBars(int x, int y, int rssi, bool force) {
   
   static int lastBars = -1;
   if (!force && activeBars == lastBars) return;
-  lastBars = activeBars;
+  displayBeginFrame();
 
+  // Only bars between the old and new level change color
+  int first = 0, last = 5;
   if (force) {
       fillRect(x, 0, 80, 20, BLACK); 
       drawText(x + 8, 6, 30, "WiFi", WHITE, BLACK, 1);
+  } else if (lastBars >= 0) {
+      first = min(activeBars, lastBars);
+      last = max(activeBars, lastBars);
   } else {
       fillRect(x + 36, 0, 44, 20, BLACK);
   }
+  lastBars = activeBars;
 
   int startX = x + 36; 
-  for (int i = 0; i < 5; i++) {
+  for (int i = first; i < last; i++) {
     int h = 4 + (i * 3);         
     int xOffset = startX + (i * 6);   
     int yOffset = 19 - h;             
@@ -217,15 +978,26 @@ void drawSignalBars(int x, int y, int rssi, bool force) {
     }
     fillRect(xOffset, yOffset, 4, h, color);
   }
+  displayEndFrame();
 }
 
 void initDisplay() {
-  pinMode(LCD_CS, OUTPUT); pinMode(LCD_DC, OUTPUT); pinMode(LCD_BL, OUTPUT);
-  digitalWrite(LCD_CS, HIGH); digitalWrite(LCD_BL, HIGH);
-  SPI.begin(SPI_SCK, SPI_MISO, SPI_MOSI, LCD_CS);
-  writeCmd(SWRESET); delay(120);
-  writeCmd(SLPOUT);  delay(120);
-  writeCmd(COLMOD); writeData(0x55);
-  writeCmd(MADCTL); writeData(0x28); 
-  writeCmd(DISPON); delay(20);
+  pinMode(LCD_BL, OUTPUT);
+  digitalWrite(LCD_BL, HIGH);
+  lcdBusBegin();
+  // Init sequence runs inline, before the display task owns the bus
+  uint8_t colmod = 0x55, madctl = 0x28;
+  lcdBusCommand(SWRESET); lcdBusWait(); delay(120);
+  lcdBusCommand(SLPOUT);  lcdBusWait(); delay(120);
+  lcdBusCommand(COLMOD); lcdBusData(&colmod, 1);
+  lcdBusCommand(MADCTL); lcdBusData(&madctl, 1); 
+  // Whole width scrolls (no fixed areas), parked at offset 0
+  uint8_t scrollDef[6] = { 0, 0, 480 >> 8, 480 & 0xFF, 0, 0 };
+  uint8_t scrollStart[2] = { 0, 0 };
+  lcdBusCommand(VSCRDEF); lcdBusData(scrollDef, 4); lcdBusData(scrollDef + 4, 2);
+  lcdBusCommand(VSCRSADD); lcdBusData(scrollStart, 2);
+  lcdBusCommand(DISPON); lcdBusWait(); delay(20);
+#if DISPLAY_PIPELINE
+  startDisplayTask();
+#endif
 }
\ No newline at end of file
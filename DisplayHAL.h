@@ -2,18 +2,122 @@
 #define DISPLAY_HAL_H
 
 #include <Arduino.h>
-#include <SPI.h>
 #include "Settings.h"
 
 // Initialize SPI and LCD (Call this in setup)
+// Also starts the display task when DISPLAY_PIPELINE is enabled.
 void initDisplay();
 
+// --- ASYNC DISPLAY PIPELINE ---
+// Draw commands are queued from any task and rendered in order by the
+// display task into DMA ping-pong buffers. The primitives below are thin
+// wrappers that submit and return; call displayFlush() when the pixels
+// must actually be on the glass (timing, sleep, reusing caller memory).
+#define DISPLAY_TEXT_RUN_MAX 80   // Glyphs per run (one 480px line at size 1)
+
+enum DisplayCmdType : uint8_t {
+  CMD_WRITE,       // Raw command or data bytes
+  CMD_WINDOW,      // CASET/RASET/RAMWR
+  CMD_PUSH_COLOR,  // Solid pixels into the open window
+  CMD_PIXELS,      // Caller RGB565 pixels into the open window
+  CMD_FILL,        // Window + solid pixels
+  CMD_GLYPHS,      // One line of glyph cells in a single window
+  CMD_CANVAS,      // Palette canvas region expanded in a single window
+  CMD_MONO,        // Scaled 1bpp bitmap in a single window
+  CMD_SYNC         // Wakes the submitting task once the bus is idle
+};
+
+struct DisplayCmd {
+  DisplayCmdType type;
+  union {
+    struct { bool isData; uint8_t len; uint8_t data[4]; } write;
+    struct { uint16_t x, y, w, h, color; } rect;
+    struct { uint16_t color; uint32_t count; } push;
+    struct { const uint16_t* data; uint32_t count; } pixels;
+    struct {
+      int16_t x, y;
+      uint16_t color, bg;
+      uint8_t size, cellW, count;
+      bool bold;
+      char text[DISPLAY_TEXT_RUN_MAX];
+    } glyphs;
+    struct {
+      const uint8_t* pixels;   // First byte of the region
+      uint16_t palette[4];
+      uint16_t stride;         // Bytes per canvas row
+      uint16_t x, y, w, h;
+    } canvas;
+    struct { const uint8_t* bits; uint16_t x, y, w, h, color, bg; uint8_t scale; } mono;
+    struct { void* waiter; } sync;
+  };
+};
+
+void displaySubmit(const DisplayCmd& cmd);
+void displayFlush();
+
+// --- DISPLAY LIST (DISPLAY_LIST) ---
+// Wrap a multi-primitive redraw in begin/end and its commands are held
+// back, then replayed with same-color fills merged and overdrawn fill
+// pixels dropped. Frames nest; displayFlush() inside one replays what has
+// been recorded so far. Frames belong to the loop task.
+void displayBeginFrame();
+void displayEndFrame();
+
 // Core Graphics Primitives
 void writeCmd(uint8_t cmd);
 void writeData(uint8_t data);
 void writeData16(uint16_t data);
 void setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
 void fillRect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color);
+
+// Bulk Pixel Streaming (Call after setAddrWindow)
+void pushColor(uint16_t color, uint32_t count);
+void writePixels(const uint16_t* pixels, uint32_t count);   // Returns once sent
+
+// Total bytes clocked out to the panel since boot (commands + pixels)
+uint32_t getSpiBytesSent();
+
+// Times full-screen and row fills through the pipeline (Serial)
+void benchmarkFill();
+
+// --- DISPLAY STATS (DISPLAY_STATS) ---
+// Call counts, inclusive microseconds and a latency histogram per probe,
+// plus bus counters. Everything here compiles out when off.
+// Primitive probes time the caller: with the pipeline or a display list
+// that is only the submit. The render probes time the same work where the
+// pixels are produced and handed to DMA (on the display task if running).
+#if DISPLAY_STATS
+enum DisplayStatProbe : uint8_t {
+  STAT_FILL_RECT,      // Caller side from here to STAT_SIGNAL_BARS
+  STAT_DRAW_CHAR,
+  STAT_DRAW_TEXT,
+  STAT_DRAW_QR,
+  STAT_SIGNAL_BARS,
+  STAT_ROW_FRAME,      // drawRowDirect (returns once the row is sent)
+  STAT_HEADER_FRAME,   // drawHeader (flushes while stats are on)
+  STAT_RENDER,         // One probe per DisplayCmdType from here
+  STAT_PROBE_COUNT = STAT_RENDER + CMD_SYNC   // CMD_SYNC only waits; not timed
+};
+void recordDisplayStat(uint8_t probe, uint32_t us);
+void printDisplayStats();   // Serial dump
+void resetDisplayStats();
+
+struct DisplayStatScope {
+  uint8_t probe;
+  unsigned long t0;
+  DisplayStatScope(uint8_t p) : probe(p), t0(micros()) {}
+  ~DisplayStatScope() { recordDisplayStat(probe, micros() - t0); }
+};
+#define DISPLAY_STAT_SCOPE(probe) DisplayStatScope displayStatScope_(probe)
+#else
+#define DISPLAY_STAT_SCOPE(probe)
+#endif
+// Hardware Scroll (VSCRDEF/VSCRSADD)
+// The panel scrolls along its gate lines, which are screen columns in
+// landscape: offset N shows memory column N at screen x = 0.
+void setScrollArea(uint16_t fixedLeft, uint16_t scrollWidth, uint16_t fixedRight);
+void setScrollOffset(uint16_t x);
+
 // Signal Meter (Hardcoded Colors)
 void drawSignalBars(int x, int y, int rssi, bool force = false);
 
@@ -21,7 +125,51 @@ void drawSignalBars(int x, int y, int rssi, bool force = false);
 void drawChar(int x, int y, char c, uint16_t color, uint16_t bg, uint8_t size);
 void drawText(int x, int y, int w, const char* str, uint16_t color, uint16_t bg, uint8_t size, bool bold = false);
 
+// Mono Canvas (Off-screen, 1 bit per pixel, MSB first; set bits are ink)
+struct MonoCanvas {
+  uint16_t width;
+  uint16_t height;
+  uint16_t stride;       // Bytes per row
+  uint8_t* bits;
+};
+void monoDrawLine(MonoCanvas& mc, int x, int y, const char* str, int len, uint8_t size);
+
+// Palette Canvas (Off-screen, 2 bits per pixel, 4 px per byte)
+// Width must be a multiple of 4 and at most 480. Compose with canvas*
+// calls using palette indices, then pushCanvas sends every pixel once.
+struct PaletteCanvas {
+  uint16_t width;
+  uint16_t height;
+  uint8_t* pixels;       // width * height / 4 bytes
+  uint16_t palette[4];   // RGB565 per index
+};
+void canvasFillRect(PaletteCanvas& cv, int x, int y, int w, int h, uint8_t colorIdx);
+void canvasDrawText(PaletteCanvas& cv, int x, int y, int w, const char* str, uint8_t colorIdx, uint8_t bgIdx, uint8_t size, bool bold = false);
+// Expands a mono canvas into two palette indices (byte-packed when x is a multiple of 4)
+void canvasBlitMono(PaletteCanvas& cv, int x, int y, const MonoCanvas& mc, uint8_t colorIdx, uint8_t bgIdx);
+// Exactly len cells on one line, no wrapping (for pre-laid-out text)
+void canvasDrawLine(PaletteCanvas& cv, int x, int y, const char* str, int len, uint8_t colorIdx, uint8_t bgIdx, uint8_t size, bool bold = false);
+void pushCanvas(const PaletteCanvas& cv, uint16_t x, uint16_t y);   // Returns once sent
+// Queues part of a canvas without waiting (srcX and w multiples of 4).
+// The pixels must stay untouched until displayFlush().
+void pushCanvasRect(const PaletteCanvas& cv, uint16_t srcX, uint16_t srcY, uint16_t w, uint16_t h, uint16_t x, uint16_t y);
+
+// 1bpp Bitmap (MSB first, rows packed back to back), each bit drawn scale x scale
+void drawMonoBitmap(uint16_t x, uint16_t y, const uint8_t* bits, uint16_t w, uint16_t h, uint8_t scale, uint16_t color, uint16_t bg);   // Returns once sent
+
 // QR Code Generator
-void drawQRCode(const char* url, const char* label);
+// Versions above 20 would need ~4KB grids on the loop task's stack inside qrcode_initText
+#define QR_MAX_VERSION  20
+#define QR_GRID_BYTES   (((4 * QR_MAX_VERSION + 17) * (4 * QR_MAX_VERSION + 17) + 7) / 8)
+struct QRImage {
+  uint8_t version;
+  uint8_t ecc;
+  uint8_t size;                    // Modules per side
+  uint8_t modules[QR_GRID_BYTES];  // Packed 1bpp, as qrcode.h lays it out
+};
+// Picks version/ECC and encodes; false if the URL is missing or too long
+bool encodeQRCode(const char* url, QRImage& out);
+void drawQRImage(const QRImage& img, const char* label);
+void drawQRCode(const char* url, const char* label);   // Encode + draw (with error screens)
 
 #endif
\ No newline at end of file
@@ -0,0 +1,438 @@
+#include "FeedReader.h"
+#include <esp_task_wdt.h>
+#include <esp32/rom/miniz.h>   // tinfl lives in ROM
+
+// --- INFLATER ---
+enum GzipStage : uint8_t { GZ_FIXED, GZ_EXTRA_LEN, GZ_EXTRA, GZ_NAME, GZ_COMMENT, GZ_HCRC, GZ_BODY };
+
+struct FeedInflater {
+  tinfl_decompressor decomp;
+  uint8_t window[TINFL_LZ_DICT_SIZE];   // tinfl's output wraps around this
+  uint8_t in[FEED_READ_BUFFER];         // Compressed body not yet inflated
+  int inPos, inLen;
+  int winPos;                           // Where tinfl writes next
+  int outPos, outEnd;                   // Inflated text not yet copied out
+  tinfl_status status;
+  GzipStage stage;
+  uint8_t flags;                        // gzip FLG bits not yet skipped
+  uint16_t count;                       // Bytes into (or left of) the header field
+  bool zlib;                            // deflate is the zlib format
+  bool done;                            // Stream ended or broke
+};
+
+FeedInflater* newFeedInflater() {
+  return (FeedInflater*)calloc(1, sizeof(FeedInflater));
+}
+
+void freeFeedInflater(FeedInflater* inflater) {
+  free(inflater);
+}
+
+static void gzipNextStage(FeedInflater& z) {
+  z.count = 0;
+  if (z.flags & 4)       { z.flags &= ~4;  z.stage = GZ_EXTRA_LEN; }
+  else if (z.flags & 8)  { z.flags &= ~8;  z.stage = GZ_NAME; }
+  else if (z.flags & 16) { z.flags &= ~16; z.stage = GZ_COMMENT; }
+  else if (z.flags & 2)  { z.flags &= ~2;  z.stage = GZ_HCRC; }
+  else z.stage = GZ_BODY;
+}
+
+// Skips the gzip member header (RFC 1952) as its bytes come in: ID1 ID2 CM
+// FLG MTIME XFL OS, then the optional extra field, name, comment and header
+// CRC. False if it isn't a deflate-compressed gzip stream.
+static bool gzipHeader(FeedInflater& z) {
+  while (z.stage != GZ_BODY && z.inPos < z.inLen) {
+    uint8_t c = z.in[z.inPos++];
+    switch (z.stage) {
+      case GZ_FIXED:
+        if ((z.count == 0 && c != 0x1f) || (z.count == 1 && c != 0x8b) || (z.count == 2 && c != 8)) return false;
+        if (z.count == 3) z.flags = c;
+        if (++z.count == 10) gzipNextStage(z);
+        break;
+      case GZ_EXTRA_LEN:
+        // Two bytes, little-endian; count then holds the length left
+        if (z.flags & 0x80) {
+          z.flags &= ~0x80;
+          z.count |= c << 8;
+          z.stage = GZ_EXTRA;
+          if (z.count == 0) gzipNextStage(z);
+        } else {
+          z.flags |= 0x80;
+          z.count = c;
+        }
+        break;
+      case GZ_EXTRA:
+        if (--z.count == 0) gzipNextStage(z);
+        break;
+      case GZ_NAME:
+      case GZ_COMMENT:
+        if (c == 0) gzipNextStage(z);
+        break;
+      case GZ_HCRC:
+        if (++z.count == 2) gzipNextStage(z);
+        break;
+      default:
+        break;
+    }
+  }
+  return true;
+}
+
+void FeedReader::begin(WiFiClient* s, bool isChunked, long contentLength, FeedEncoding encoding, FeedInflater* z) {
+  stream = s;
+  chunked = isChunked;
+  pos = len = 0;
+  lineLen = 0;
+  chunkSize = 0;
+  wireBytes = textBytes = 0;
+  if (chunked) {
+    state = CHUNK_SIZE;
+    remaining = 0;
+  } else {
+    remaining = contentLength;
+    state = (contentLength == 0) ? BODY_DONE : BODY_DATA;
+  }
+  inflater = (encoding == FEED_IDENTITY) ? NULL : z;
+  inflating = (inflater != NULL);
+  if (inflater) {
+    tinfl_init(&z->decomp);
+    z->inPos = z->inLen = 0;
+    z->winPos = z->outPos = z->outEnd = 0;
+    z->status = TINFL_STATUS_NEEDS_MORE_INPUT;
+    z->stage = (encoding == FEED_GZIP) ? GZ_FIXED : GZ_BODY;
+    z->flags = 0;
+    z->count = 0;
+    z->zlib = (encoding == FEED_DEFLATE);
+    z->done = false;
+  }
+}
+
+// One byte of chunk framing: "<hex>[;ext]\r\n" <data> "\r\n" ... "0\r\n" <trailers> "\r\n"
+void FeedReader::framing(char c) {
+  switch (state) {
+    case CHUNK_SIZE:
+    case CHUNK_EXT:
+      if (c == '\n') {
+        if (chunkSize == 0) { state = CHUNK_TRAILER; lineLen = 0; }
+        else { remaining = chunkSize; state = BODY_DATA; }
+        chunkSize = 0;
+      } else if (state == CHUNK_SIZE) {
+        if (c >= '0' && c <= '9') chunkSize = chunkSize * 16 + (c - '0');
+        else if (c >= 'a' && c <= 'f') chunkSize = chunkSize * 16 + (c - 'a' + 10);
+        else if (c >= 'A' && c <= 'F') chunkSize = chunkSize * 16 + (c - 'A' + 10);
+        else if (c != '\r') state = CHUNK_EXT;
+      }
+      break;
+    case CHUNK_DATA_END:
+      if (c == '\n') state = CHUNK_SIZE;
+      break;
+    case CHUNK_TRAILER:
+      // Trailer lines until an empty one
+      if (c == '\n') {
+        if (lineLen == 0) state = BODY_DONE;
+        lineLen = 0;
+      } else if (c != '\r') {
+        lineLen++;
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+// Moves whatever body the client already has into dst without waiting,
+// decoding chunk framing on the way; returns the body bytes stored
+int FeedReader::readBody(uint8_t* dst, int room) {
+  int stored = 0;
+  while (stored < room && state != BODY_DONE) {
+    int avail = stream->available();
+    if (avail <= 0) break;
+    if (state == BODY_DATA) {
+      int want = room - stored;
+      if (remaining >= 0 && remaining < want) want = remaining;
+      if (avail < want) want = avail;
+      int n = stream->read(dst + stored, want);
+      if (n <= 0) break;
+      stored += n;
+      wireBytes += n;
+      if (remaining > 0) {
+        remaining -= n;
+        if (remaining == 0) state = chunked ? CHUNK_DATA_END : BODY_DONE;
+      }
+    } else {
+      int c = stream->read();
+      if (c < 0) break;
+      wireBytes++;
+      framing((char)c);
+    }
+  }
+  return stored;
+}
+
+// Inflates what has arrived into the free end of buf; returns the text added
+int FeedReader::inflate() {
+  FeedInflater& z = *inflater;
+  int added = 0;
+  while (len < (int)sizeof(buf)) {
+    // Hand out what the last call left in the window first
+    if (z.outPos < z.outEnd) {
+      int n = z.outEnd - z.outPos;
+      if (n > (int)sizeof(buf) - len) n = sizeof(buf) - len;
+      memcpy(buf + len, z.window + z.outPos, n);
+      z.outPos += n;
+      len += n;
+      added += n;
+      continue;
+    }
+    if (z.done) { inflating = false; break; }
+
+    // tinfl only wants more input once it has no output left to give
+    if (z.inPos == z.inLen && z.status != TINFL_STATUS_HAS_MORE_OUTPUT) {
+      z.inPos = 0;
+      z.inLen = readBody(z.in, sizeof(z.in));
+      if (z.inLen == 0 && state != BODY_DONE) break;
+    }
+    if (z.stage != GZ_BODY) {
+      if (!gzipHeader(z)) {
+        Serial.println("[WARN] Feed body isn't gzip");
+        z.done = true;
+      } else if (z.stage != GZ_BODY && state == BODY_DONE && z.inPos == z.inLen) {
+        Serial.println("[WARN] Feed body ends inside its gzip header");
+        z.done = true;
+      }
+      continue;
+    }
+
+    size_t inSize = z.inLen - z.inPos;
+    size_t outSize = TINFL_LZ_DICT_SIZE - z.winPos;
+    mz_uint32 flags = (state != BODY_DONE ? TINFL_FLAG_HAS_MORE_INPUT : 0) | (z.zlib ? TINFL_FLAG_PARSE_ZLIB_HEADER : 0);
+    z.status = tinfl_decompress(&z.decomp, z.in + z.inPos, &inSize, z.window, z.window + z.winPos, &outSize, flags);
+    z.inPos += inSize;
+    z.outPos = z.winPos;
+    z.outEnd = z.winPos + outSize;
+    z.winPos = (z.winPos + outSize) & (TINFL_LZ_DICT_SIZE - 1);
+    if (z.status == TINFL_STATUS_DONE) {
+      z.done = true;   // The gzip trailer is left for drain()
+    } else if (z.status < 0) {
+      Serial.println("[WARN] Feed body failed to inflate");
+      z.done = true;
+    }
+  }
+  return added;
+}
+
+// Tops up the buffer from the client without waiting; returns how far it
+// got (stream bytes consumed plus text inflated), 0 if nothing moved
+int FeedReader::fill() {
+  if (pos > 0) {
+    memmove(buf, buf + pos, len - pos);
+    len -= pos;
+    pos = 0;
+  }
+  uint32_t before = wireBytes;
+  int added = inflater ? inflate() : readBody((uint8_t*)buf + len, sizeof(buf) - len);
+  if (!inflater) len += added;
+  textBytes += added;
+  return (wireBytes - before) + added;
+}
+
+// Waits until there's unread body; false once it has ended, the stream
+// stays empty for maxStalls polls in a row, or timeoutMs has passed
+bool FeedReader::await(unsigned long start, unsigned long timeoutMs, int maxStalls) {
+  int stalls = 0;
+  while (pos == len) {
+    if (inflater ? !inflating : state == BODY_DONE) return false;
+    if (millis() - start >= timeoutMs) return false;
+    esp_task_wdt_reset();
+    if (fill() > 0) { stalls = 0; continue; }
+    if (++stalls >= maxStalls) {
+      Serial.println("[DEBUG] Stream timeout in FeedReader");
+      return false;
+    }
+    delay(10);
+  }
+  return true;
+}
+
+bool FeedReader::find(const char* target) {
+  unsigned long start = millis();
+  int targetLen = strlen(target);
+  int matchIdx = 0;
+
+  while (await(start, PARSE_TIMEOUT_MS, 3)) {
+    const char* p = buf + pos;
+    const char* end = buf + len;
+    while (p < end) {
+      if (matchIdx == 0) {
+        p = (const char*)memchr(p, target[0], end - p);
+        if (!p) { p = end; break; }
+      }
+      char c = *p++;
+      if (c == target[matchIdx]) {
+        if (++matchIdx == targetLen) { pos = p - buf; return true; }
+      } else {
+        matchIdx = (c == target[0]) ? 1 : 0;
+      }
+    }
+    pos = len;
+  }
+  return false;
+}
+
+// --- ITEM TOKENIZER ---
+// A byte-at-a-time state machine over the buffer: text, tag names,
+// attributes (skipped, quotes respected), CDATA and comments. Only direct
+// children of the item named in fields[] are captured, each once.
+namespace {
+struct FieldSlot {
+  const char* name;
+  char* text;
+  int cap;
+  uint8_t bit;
+};
+enum TokenState { TOK_TEXT, TOK_TAG, TOK_ATTRS, TOK_CDATA, TOK_COMMENT };
+}
+
+bool FeedReader::readItem(FeedItem& item, unsigned long timeoutMs) {
+  FieldSlot fields[] = {
+    { "title",           item.title,       sizeof(item.title),       FEED_TITLE },
+    { "link",            item.link,        sizeof(item.link),        FEED_LINK },
+    { "guid",            item.guid,        sizeof(item.guid),        FEED_GUID },
+    { "pubDate",         item.pubDate,     sizeof(item.pubDate),     FEED_PUBDATE },
+    { "description",     item.description, sizeof(item.description), FEED_DESCRIPTION },
+    { "source",          item.source,      sizeof(item.source),      FEED_SOURCE },
+    { "content:encoded", item.content,     sizeof(item.content),     FEED_CONTENT },
+  };
+  const int fieldCount = sizeof(fields) / sizeof(fields[0]);
+  int lens[fieldCount] = {0};
+  item.seen = 0;
+  item.truncated = 0;
+
+  int field = -1;        // Field being captured
+  int skipDepth = 0;     // Other elements open inside the item
+  TokenState tok = TOK_TEXT;
+  char name[24];         // Tag name, '/' first for a closing tag (longer names are cut)
+  int nameLen = 0;
+  char quote = 0, last = 0;
+  int marks = 0;         // Run of ']' (CDATA) or '-' (comment) before a possible end
+
+  // Appends to the field being captured, or counts it as cut
+  auto put = [&](char c) {
+    if (field < 0) return;
+    if (lens[field] < fields[field].cap - 1) fields[field].text[lens[field]++] = c;
+    else item.truncated |= fields[field].bit;
+  };
+  auto putTag = [&](bool selfClose) {
+    put('<');
+    for (int i = 0; i < nameLen; i++) put(name[i]);
+    if (selfClose) put('/');
+    put('>');
+  };
+
+  unsigned long start = millis();
+  while (await(start, timeoutMs, 6)) {
+    const char* p = buf + pos;
+    const char* end = buf + len;
+    while (p < end) {
+      char c = *p++;
+      switch (tok) {
+        case TOK_TEXT:
+          if (c == '<') { tok = TOK_TAG; nameLen = 0; }
+          else put(c);
+          break;
+
+        case TOK_CDATA:
+          if (c == ']') { marks++; break; }
+          if (c == '>' && marks >= 2) {
+            for (int i = 2; i < marks; i++) put(']');
+            tok = TOK_TEXT;
+          } else {
+            for (int i = 0; i < marks; i++) put(']');
+            put(c);
+          }
+          marks = 0;
+          break;
+
+        case TOK_COMMENT:
+          if (c == '>' && marks >= 2) tok = TOK_TEXT;
+          marks = (c == '-') ? marks + 1 : 0;
+          break;
+
+        case TOK_TAG:
+          if (c != '>' && c != ' ' && c != '\t' && c != '\r' && c != '\n' && !(c == '/' && nameLen > 0)) {
+            if (nameLen < (int)sizeof(name) - 1) name[nameLen++] = c;
+            if (nameLen == 8 && memcmp(name, "![CDATA[", 8) == 0) { tok = TOK_CDATA; marks = 0; }
+            else if (nameLen == 3 && memcmp(name, "!--", 3) == 0) { tok = TOK_COMMENT; marks = 0; }
+            break;
+          }
+          name[nameLen] = 0;
+          last = c;
+          quote = 0;
+          if (c != '>') { tok = TOK_ATTRS; break; }
+          // fall through: the tag ends here
+        case TOK_ATTRS:
+          if (tok == TOK_ATTRS) {
+            if (quote) { if (c == quote) quote = 0; break; }
+            if (c == '"' || c == '\'') { quote = c; break; }
+            if (c != '>') { if (c != ' ' && c != '\t' && c != '\r' && c != '\n') last = c; break; }
+          }
+          tok = TOK_TEXT;
+          {
+            bool selfClose = (last == '/');
+            if (name[0] == '/') {
+              if (field >= 0) {
+                if (strcmp(name + 1, fields[field].name) == 0) field = -1;
+                else putTag(false);
+              } else if (skipDepth > 0) {
+                skipDepth--;
+              } else if (strcmp(name + 1, "item") == 0) {
+                pos = p - buf;
+                for (int i = 0; i < fieldCount; i++) fields[i].text[lens[i]] = 0;
+                return true;
+              }
+            } else if (name[0] == '?' || name[0] == '!') {
+              // Declarations and processing instructions carry nothing
+            } else if (field >= 0) {
+              putTag(selfClose);   // Inner markup stays for the HTML strippers
+            } else if (skipDepth == 0) {
+              int k = -1;
+              for (int i = 0; i < fieldCount; i++) {
+                if (!(item.seen & fields[i].bit) && strcmp(name, fields[i].name) == 0) { k = i; break; }
+              }
+              if (k >= 0) {
+                item.seen |= fields[k].bit;
+                if (!selfClose) field = k;
+              } else if (!selfClose) {
+                skipDepth++;
+              }
+            } else if (!selfClose) {
+              skipDepth++;
+            }
+          }
+          break;
+      }
+    }
+    pos = len;
+  }
+  Serial.println("[WARN] Item incomplete (no closing tag found)");
+  for (int i = 0; i < fieldCount; i++) fields[i].text[lens[i]] = 0;
+  return false;
+}
+
+bool FeedReader::drain(long maxBytes, uint32_t& drained) {
+  // A body that runs until the server closes can't leave the connection reusable
+  if (!chunked && remaining < 0 && state != BODY_DONE) return false;
+  // The compressed rest only needs skipping, not inflating
+  inflater = NULL;
+  inflating = false;
+  unsigned long start = millis();
+  long count = 0;
+  while (true) {
+    count += len - pos;
+    pos = len;
+    if (state == BODY_DONE) break;
+    if (count > maxBytes || !await(start, PARSE_TIMEOUT_MS, 20)) break;
+  }
+  drained += count;
+  return state == BODY_DONE;
+}
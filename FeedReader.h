@@ -0,0 +1,90 @@
+#ifndef FEED_READER_H
+#define FEED_READER_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include "Settings.h"
+
+// --- ITEM FIELDS ---
+// One RSS <item> as the tokenizer leaves it: CDATA wrappers gone, entities
+// and any inner markup left for cleanText / stripAllHtmlTags. Each field
+// keeps at most its capacity (NUL included); the rest is skipped unbuffered.
+enum FeedFieldBit : uint8_t {
+  FEED_TITLE = 1, FEED_LINK = 2, FEED_GUID = 4, FEED_PUBDATE = 8,
+  FEED_DESCRIPTION = 16, FEED_SOURCE = 32, FEED_CONTENT = 64
+};
+struct FeedItem {
+  char title[FEED_TITLE_CHARS];
+  char link[FEED_LINK_CHARS];
+  char guid[FEED_LINK_CHARS];
+  char pubDate[48];
+  char description[FEED_DESC_CHARS];
+  char source[64];
+  char content[FEED_CONTENT_CHARS];   // Start of <content:encoded>
+  uint8_t seen;        // FeedFieldBits whose element turned up
+  uint8_t truncated;   // ...and those cut at capacity
+};
+
+// --- CONTENT ENCODING ---
+// A compressed body is inflated under the reader with the ROM's tinfl. Its
+// state and 32 KB window (~44 KB) live in a FeedInflater the caller keeps
+// and reuses; NULL if the heap can't spare one.
+enum FeedEncoding : uint8_t { FEED_IDENTITY, FEED_GZIP, FEED_DEFLATE };
+struct FeedInflater;
+FeedInflater* newFeedInflater();
+void freeFeedInflater(FeedInflater* inflater);
+
+// --- BUFFERED FEED READER ---
+// Pulls a response body off the client FEED_READ_BUFFER bytes at a time and
+// scans it in place, instead of one stream->read() (and watchdog reset) per
+// byte. Chunked transfer framing is decoded underneath, so callers only see
+// feed text, and the end of a chunked or sized body is known exactly. A
+// gzip or deflate body is inflated between the two. One reader per fetch;
+// not shared between tasks.
+class FeedReader {
+public:
+  // contentLength < 0: unknown (chunked, or runs until the server closes).
+  // A compressed encoding needs an inflater.
+  void begin(WiFiClient* stream, bool chunked, long contentLength,
+             FeedEncoding encoding = FEED_IDENTITY, FeedInflater* inflater = NULL);
+
+  // Skips to just past target; false if the body ends or stalls first
+  bool find(const char* target);
+
+  // Tokenizes the rest of an <item> (call after find("<item>")) straight
+  // into item's fields, skipping other elements, comments and anything past
+  // a field's capacity; false if </item> doesn't turn up within timeoutMs
+  bool readItem(FeedItem& item, unsigned long timeoutMs);
+
+  // Reads off the rest of the body so a keep-alive connection sits at the
+  // next response; false if its end can't be reached within maxBytes
+  bool drain(long maxBytes, uint32_t& drained);
+
+  bool ended() const { return (inflater ? !inflating : state == BODY_DONE) && pos == len; }
+
+  uint32_t received() const { return wireBytes; }   // Off the stream, framing included
+  uint32_t decoded() const { return textBytes; }    // Feed text handed to the parser
+
+private:
+  enum BodyState { BODY_DATA, CHUNK_SIZE, CHUNK_EXT, CHUNK_DATA_END, CHUNK_TRAILER, BODY_DONE };
+
+  int fill();
+  int readBody(uint8_t* dst, int room);
+  int inflate();
+  bool await(unsigned long start, unsigned long timeoutMs, int maxStalls);
+  void framing(char c);
+
+  WiFiClient* stream = NULL;
+  bool chunked = false;
+  BodyState state = BODY_DONE;
+  long remaining = -1;     // Bytes left in this chunk (or the body); -1 = until close
+  long chunkSize = 0;
+  int lineLen = 0;         // Trailer line being skipped
+  char buf[FEED_READ_BUFFER];
+  int pos = 0, len = 0;    // Unread bytes are buf[pos..len)
+  FeedInflater* inflater = NULL;
+  bool inflating = false;  // The inflater may still have text to hand out
+  uint32_t wireBytes = 0, textBytes = 0;
+};
+
+#endif
@@ -0,0 +1,139 @@
+#include "LcdBus.h"
+#include <driver/spi_master.h>
+#include <driver/gpio.h>
+#include <esp_heap_caps.h>
+
+// HSPI sits on the IOMUX pins (12/13/14/15), so 40MHz needs no GPIO matrix
+#define LCD_SPI_HOST    SPI2_HOST
+#define LCD_SPI_HZ      40000000
+#define LCD_QUEUE_SLOTS 16
+
+static spi_device_handle_t lcdDev;
+static spi_transaction_t slots[LCD_QUEUE_SLOTS];
+static uint8_t slotHead = 0;     // Next slot to hand out (completions come back in order)
+static uint8_t inFlight = 0;
+
+static uint8_t* pixelBuf[2];
+static volatile bool bufBusy[2] = {false, false};
+static uint8_t curBuf = 0;
+static uint32_t bytesSent = 0;
+#if DISPLAY_STATS
+static uint32_t transactions = 0;
+static uint32_t windowsSet = 0;
+#endif
+
+// t->user: bit 0 = DC level, bits 1+ = pixel buffer index + 1 (0 = none)
+static void IRAM_ATTR lcdPreTransfer(spi_transaction_t* t) {
+  gpio_set_level((gpio_num_t)LCD_DC, (uintptr_t)t->user & 1);
+}
+
+static void reapOne() {
+  spi_transaction_t* done;
+  spi_device_get_trans_result(lcdDev, &done, portMAX_DELAY);
+  uint32_t buf = (uintptr_t)done->user >> 1;
+  if (buf) bufBusy[buf - 1] = false;
+  inFlight--;
+}
+
+static spi_transaction_t* nextSlot() {
+  if (inFlight == LCD_QUEUE_SLOTS) reapOne();
+  spi_transaction_t* t = &slots[slotHead];
+  slotHead = (slotHead + 1) % LCD_QUEUE_SLOTS;
+  memset(t, 0, sizeof(*t));
+  return t;
+}
+
+static void queueSlot(spi_transaction_t* t) {
+  spi_device_queue_trans(lcdDev, t, portMAX_DELAY);
+  inFlight++;
+  bytesSent += t->length / 8;
+#if DISPLAY_STATS
+  transactions++;
+#endif
+}
+
+void lcdBusBegin() {
+  pinMode(LCD_DC, OUTPUT);
+
+  spi_bus_config_t bus;
+  memset(&bus, 0, sizeof(bus));
+  bus.mosi_io_num = SPI_MOSI;
+  bus.miso_io_num = -1;            // Write-only panel
+  bus.sclk_io_num = SPI_SCK;
+  bus.quadwp_io_num = -1;
+  bus.quadhd_io_num = -1;
+  bus.max_transfer_sz = LCD_BUS_BUFFER_BYTES;
+  spi_bus_initialize(LCD_SPI_HOST, &bus, SPI_DMA_CH_AUTO);
+
+  spi_device_interface_config_t dev;
+  memset(&dev, 0, sizeof(dev));
+  dev.clock_speed_hz = LCD_SPI_HZ;
+  dev.mode = 0;
+  dev.spics_io_num = LCD_CS;
+  dev.queue_size = LCD_QUEUE_SLOTS;
+  dev.pre_cb = lcdPreTransfer;
+  spi_bus_add_device(LCD_SPI_HOST, &dev, &lcdDev);
+
+  pixelBuf[0] = (uint8_t*)heap_caps_malloc(LCD_BUS_BUFFER_BYTES, MALLOC_CAP_DMA);
+  pixelBuf[1] = (uint8_t*)heap_caps_malloc(LCD_BUS_BUFFER_BYTES, MALLOC_CAP_DMA);
+}
+
+void lcdBusCommand(uint8_t cmd) {
+  spi_transaction_t* t = nextSlot();
+  t->flags = SPI_TRANS_USE_TXDATA;
+  t->length = 8;
+  t->tx_data[0] = cmd;
+  t->user = (void*)0;
+  queueSlot(t);
+}
+
+void lcdBusData(const uint8_t* data, uint8_t len) {
+  if (len == 0 || len > 4) return;
+  spi_transaction_t* t = nextSlot();
+  t->flags = SPI_TRANS_USE_TXDATA;
+  t->length = len * 8;
+  memcpy(t->tx_data, data, len);
+  t->user = (void*)1;
+  queueSlot(t);
+}
+
+void lcdBusSetWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+#if DISPLAY_STATS
+  windowsSet++;
+#endif
+  uint16_t x1 = x + w - 1, y1 = y + h - 1;
+  uint8_t cols[4] = { (uint8_t)(x >> 8), (uint8_t)(x & 0xFF), (uint8_t)(x1 >> 8), (uint8_t)(x1 & 0xFF) };
+  uint8_t rows[4] = { (uint8_t)(y >> 8), (uint8_t)(y & 0xFF), (uint8_t)(y1 >> 8), (uint8_t)(y1 & 0xFF) };
+  lcdBusCommand(CASET); lcdBusData(cols, 4);
+  lcdBusCommand(RASET); lcdBusData(rows, 4);
+  lcdBusCommand(RAMWR);
+}
+
+uint8_t* lcdBusPixelBuffer() {
+  while (bufBusy[curBuf]) reapOne();
+  return pixelBuf[curBuf];
+}
+
+void lcdBusQueuePixels(uint32_t bytes) {
+  if (bytes == 0) return;
+  spi_transaction_t* t = nextSlot();
+  t->length = bytes * 8;
+  t->tx_buffer = pixelBuf[curBuf];
+  t->user = (void*)(uintptr_t)(1 | ((curBuf + 1) << 1));
+  bufBusy[curBuf] = true;
+  queueSlot(t);
+  curBuf ^= 1;
+}
+
+void lcdBusWait() {
+  while (inFlight) reapOne();
+}
+
+uint32_t lcdBusBytesSent() { return bytesSent; }
+
+#if DISPLAY_STATS
+void lcdBusStats(uint32_t& tx, uint32_t& windows) {
+  tx = transactions;
+  windows = windowsSet;
+}
+#endif
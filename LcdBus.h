@@ -0,0 +1,47 @@
+#ifndef LCD_BUS_H
+#define LCD_BUS_H
+
+#include <Arduino.h>
+#include "Settings.h"
+
+// --- ST7796 COMMANDS ---
+#define SWRESET     0x01
+#define SLPOUT      0x11
+#define DISPON      0x29
+#define CASET       0x2A
+#define RASET       0x2B
+#define RAMWR       0x2C
+#define VSCRDEF     0x33
+#define MADCTL      0x36
+#define VSCRSADD    0x37
+#define COLMOD      0x3A
+
+// Size of each of the two DMA pixel buffers (4 full scanlines)
+#define LCD_BUS_BUFFER_BYTES (480 * 2 * 4)
+
+// Low-level panel bus. Only the display render context may call these
+// (the display task, or the caller when DISPLAY_PIPELINE is off).
+// Everything is queued in order; nothing blocks unless a buffer or
+// transaction slot is still on the wire.
+void lcdBusBegin();
+void lcdBusCommand(uint8_t cmd);
+void lcdBusData(const uint8_t* data, uint8_t len);   // len <= 4
+void lcdBusSetWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+
+// Ping-pong pixel buffers: fill the current one, queue it, and the bus
+// hands out the other while the first goes out over DMA.
+uint8_t* lcdBusPixelBuffer();
+void lcdBusQueuePixels(uint32_t bytes);
+
+// Blocks until every queued transaction has left the bus
+void lcdBusWait();
+
+// Total bytes clocked out since boot (commands + pixels)
+uint32_t lcdBusBytesSent();
+
+#if DISPLAY_STATS
+// SPI transactions queued and address windows set since boot
+void lcdBusStats(uint32_t& transactions, uint32_t& windows);
+#endif
+
+#endif
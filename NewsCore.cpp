@@ -1,17 +1,24 @@
 #include "NewsCore.h"
-#include <HTTPClient.h>
+#include "FeedReader.h"
 #include <WiFiClientSecure.h>
 #include <esp_task_wdt.h>
 #include <algorithm>
+#include <climits>
+#include <new>
 #include <set> 
 
 // --- GLOBAL STORAGE ---
 std::vector<Story> megaPool;
+uint32_t megaPoolGeneration = 0;
 std::vector<int> playbackQueue; // The "Deck of Cards" for display
 int failureCount = 0;
 bool lastSyncFailed = false; 
 
 // --- SOURCE-LEVEL STATISTICS ---
+// How a source's read went, as its circuit breaker sees it
+enum FetchOutcome : uint8_t { OUTCOME_OK, OUTCOME_SKIPPED, OUTCOME_TIMEOUT, OUTCOME_HTTP_ERROR, OUTCOME_PARSE_ERROR };
+enum BreakerState : uint8_t { BREAKER_CLOSED, BREAKER_OPEN, BREAKER_HALF_OPEN };
+
 struct SourceStats {
   int fetched = 0;      // Total items fetched
   int accepted = 0;    // Items added to pool
@@ -19,6 +26,27 @@ struct SourceStats {
   int parseErrors = 0; // Parse/validation failures
   int consecutiveFails = 0; // Consecutive failures
   unsigned long lastFetchMs = 0; // Last fetch timestamp
+  unsigned long lastDurationMs = 0; // How long the last fetch took
+  // Conditional GET (kept across batches)
+  int checks = 0;       // Fetches that reached the server
+  int unchanged = 0;    // ...answered 304 or matching the stored digest
+  String etag;          // Validators from the last full read
+  String lastModified;
+  uint32_t itemDigest = 0;  // First <item> of the last read, when neither header is sent
+  // Adaptive schedule (see SCHEDULER)
+  float newPerHour = 0;          // EWMA of stories the pool didn't have yet, per hour
+  int lastNew = 0;               // ...and how many the last read brought
+  unsigned long sampledMs = 0;   // Last read that fed the rate (0 = none yet)
+  unsigned long nextDueMs = 0;   // 0 = never scheduled: due now, outside the budget
+  // Circuit breaker (see CIRCUIT BREAKER)
+  uint8_t breaker = BREAKER_CLOSED;
+  uint8_t timeouts = 0;          // Consecutive failures, by kind
+  uint8_t httpErrors = 0;
+  uint8_t parseFails = 0;
+  uint8_t reopens = 0;           // Failed probes since it last closed: doubles the open period
+  uint8_t openedBy = OUTCOME_OK; // Failure kind that opened it
+  int opens = 0;                 // Times opened (stats)
+  unsigned long openUntilMs = 0;
 };
 SourceStats sourceStats[30] = {};
 
@@ -95,6 +123,16 @@ void resetPlaybackQueue() {
     #endif
 }
 
+// --- HELPER: PEEK UPCOMING STORIES ---
+// Cards nearest the top of the deck; getNextStoryIndex may still skip some
+int peekUpcomingStories(int* out, int maxCount) {
+    int n = 0;
+    for (int i = (int)playbackQueue.size() - 1; i >= 0 && n < maxCount; i--) {
+        if (playbackQueue[i] < megaPool.size()) out[n++] = playbackQueue[i];
+    }
+    return n;
+}
+
 // --- HELPER: GET NEXT UNIQUE STORY ---
 int getNextStoryIndex(const std::vector<int>& forbiddenSources) {
     #ifdef DEBUG_MODE
@@ -288,7 +326,7 @@ String cleanText(String raw) {
   }
   raw.trim();
 
-  // 8. Smart Crop (114 Chars)
+  // 8. Safety Crop (layoutHeadline trims to what fits on screen)
   if (raw.length() > MAX_HEADLINE_LEN) {
       int cutOff = raw.lastIndexOf(' ', MAX_HEADLINE_LEN - 3);
       if (cutOff > 0) {
@@ -311,6 +349,54 @@ String cleanText(String raw) {
   return raw;
 }
 
+// --- HEADLINE LAYOUT ---
+// Breaks at spaces (hard-splitting words longer than a line). If the text
+// runs past the last line, that line is cut back to a word so "..." fits.
+void layoutHeadline(Story& s) {
+  const char* text = s.headline.c_str();
+  int len = min((int)s.headline.length(), 255);
+  int pos = 0;
+  s.lineCount = 0;
+  s.ellipsis = false;
+
+  while (s.lineCount < HEADLINE_MAX_LINES) {
+    while (pos < len && text[pos] == ' ') pos++;
+    if (pos >= len) break;
+
+    int end = len;
+    if (len - pos > HEADLINE_LINE_CHARS) {
+      end = pos + HEADLINE_LINE_CHARS;
+      // A space right after the last cell still allows a full line
+      int brk = end;
+      while (brk > pos && text[brk] != ' ') brk--;
+      if (brk > pos) end = brk;
+    }
+    int lineEnd = end;
+    while (lineEnd > pos && text[lineEnd - 1] == ' ') lineEnd--;
+    s.lineStart[s.lineCount] = pos;
+    s.lineLen[s.lineCount] = lineEnd - pos;
+    s.lineCount++;
+    pos = end;
+  }
+
+  while (pos < len && text[pos] == ' ') pos++;
+  if (pos >= len || s.lineCount == 0) return;
+
+  // Overflow: make room for the ellipsis on the last line
+  int last = s.lineCount - 1;
+  int start = s.lineStart[last];
+  int room = HEADLINE_LINE_CHARS - 3;
+  if (s.lineLen[last] > room) {
+    int cut = start + room;
+    int brk = cut;
+    while (brk > start && text[brk] != ' ') brk--;
+    if (brk > start + room / 2) cut = brk;   // Don't strand a near-empty line
+    while (cut > start && text[cut - 1] == ' ') cut--;
+    s.lineLen[last] = cut - start;
+  }
+  s.ellipsis = true;
+}
+
 String stripWpMediaTags(String raw) {
     int idx = raw.indexOf("<img");
     while (idx >= 0) {
@@ -563,124 +649,6 @@ bool isValidStory(String headline) {
     return true; 
 }
 
-bool safeFind(WiFiClient* stream, const char* target) {
-    unsigned long start = millis();
-    int len = strlen(target);
-    int matchIdx = 0;
-    int consecutiveTimeouts = 0;
-    const int MAX_TIMEOUTS = 3;
-    
-    while(millis() - start < PARSE_TIMEOUT_MS) {
-        esp_task_wdt_reset(); 
-        if(stream->available()) {
-            consecutiveTimeouts = 0;
-            char c = stream->read();
-            if(c == target[matchIdx]) {
-                matchIdx++;
-                if(matchIdx == len) return true;
-            } else { 
-                matchIdx = (c == target[0]) ? 1 : 0;
-            }
-        } else { 
-            consecutiveTimeouts++;
-            if (consecutiveTimeouts >= MAX_TIMEOUTS) {
-                Serial.println("[DEBUG] Stream timeout in safeFind");
-                return false;
-            }
-            delay(10); 
-        }
-    }
-    return false; 
-}
-
-String safeReadUntil(WiFiClient* stream, char terminator) {
-    String res = "";
-    unsigned long start = millis();
-    while(millis() - start < PARSE_TIMEOUT_MS) {
-        esp_task_wdt_reset(); 
-        if(stream->available()) {
-            char c = stream->read();
-            if(c == terminator) return res;
-            if(res.length() < 300) res += c; 
-        } else { delay(10); }
-    }
-    return res;
-}
-
-String safeReadUntilEndTagWithTimeout(WiFiClient* stream, const char* endTag, int maxLen, int timeoutMs) {
-    String res = "";
-    String tail = "";
-    int endLen = strlen(endTag);
-    unsigned long start = millis();
-    int consecutiveTimeouts = 0;
-    bool hitMaxLen = false;
-    
-    while (millis() - start < (unsigned long)timeoutMs) {
-        esp_task_wdt_reset();
-        if (stream->available()) {
-            consecutiveTimeouts = 0;
-            char c = stream->read();
-            if (res.length() < maxLen) res += c;
-            else hitMaxLen = true;
-            tail += c;
-            if (tail.length() > endLen) tail.remove(0, tail.length() - endLen);
-            if (tail.endsWith(endTag)) {
-                if (res.endsWith(endTag)) res.remove(res.length() - endLen);
-                if (hitMaxLen) Serial.print("[WARN] Item truncated at "), Serial.print(maxLen), Serial.println(" bytes");
-                return res;
-            }
-        } else { 
-            consecutiveTimeouts++;
-            if (consecutiveTimeouts > 5) {
-                Serial.println("[DEBUG] Stream timeout in safeReadUntilTag");
-                break;
-            }
-            delay(10); 
-        }
-    }
-    if (!res.endsWith(endTag)) {
-        Serial.println("[WARN] Item incomplete (no closing tag found)");
-        return "";
-    }
-    return res;
-}
-
-String safeReadUntilEndTag(WiFiClient* stream, const char* endTag, int maxLen) {
-    String res = "";
-    String tail = "";
-    int endLen = strlen(endTag);
-    unsigned long start = millis();
-    while (millis() - start < PARSE_TIMEOUT_MS) {
-        esp_task_wdt_reset();
-        if (stream->available()) {
-            char c = stream->read();
-            if (res.length() < maxLen) res += c;
-            tail += c;
-            if (tail.length() > endLen) tail.remove(0, tail.length() - endLen);
-            if (tail.endsWith(endTag)) {
-                if (res.endsWith(endTag)) res.remove(res.length() - endLen);
-                return res;
-            }
-        } else { delay(10); }
-    }
-    return res;
-}
-
-String extractTagValue(const String& xml, const char* openTag, const char* closeTag) {
-    int start = xml.indexOf(openTag);
-    if (start < 0) {
-        Serial.print("[WARN] Missing tag: "), Serial.println(openTag);
-        return "";
-    }
-    start += strlen(openTag);
-    int end = xml.indexOf(closeTag, start);
-    if (end < 0 || end <= start) {
-        Serial.print("[WARN] Malformed tag: "), Serial.println(closeTag);
-        return "";
-    }
-    return xml.substring(start, end);
-}
-
 time_t parseRSSDate(String d) {
   struct tm t = {0};
   d.trim();
@@ -709,7 +677,8 @@ time_t parseRSSDate(String d) {
 String formatTime(time_t raw) {
   if(raw < 1704067200) return ""; 
   time_t local = raw + (USER_TIMEZONE_HOUR * 3600);
-  struct tm* t = gmtime(&local); 
+  struct tm parts;
+  struct tm* t = gmtime_r(&local, &parts);   // Fetch workers call this concurrently
   int hour = t->tm_hour;
   const char* suffix = "AM";
   if (hour >= 12) { suffix = "PM"; if (hour > 12) hour -= 12; }
@@ -730,7 +699,186 @@ void ensureWiFi() {
   if (WiFi.status() != WL_CONNECTED) failureCount++; else failureCount = 0;
 }
 
-void fetchAndPool(int sourceIdx) {
+// --- FETCH SLOTS ---
+// One per source of the batch in flight. A worker owns its slot until the
+// phase reads FETCH_DONE; the loop task only reads phase/found for progress.
+enum FetchPhase : uint8_t { FETCH_QUEUED, FETCH_CONNECTING, FETCH_PARSING, FETCH_DONE };
+struct FetchSlot {
+  std::vector<Story> stories;
+  volatile uint8_t phase = FETCH_QUEUED;
+  volatile uint8_t found = 0;    // Stories accepted so far
+  bool ok = true;
+  bool unchanged = false;        // Feed not modified: keep this source's pool entries
+  bool replaces = false;         // Complete read (or a first one): stories take over the source's entries
+  uint8_t handshakes = 0;        // New TLS connections this source needed
+  bool reused = false;           // Went out on the previous source's connection
+  uint32_t drained = 0;          // Body bytes read past the parse to keep the connection
+  uint32_t received = 0;         // Body bytes off the air up to the end of the parse...
+  uint32_t decoded = 0;          // ...and the feed text they came to
+  bool compressed = false;
+  uint8_t outcome = OUTCOME_SKIPPED;
+  int httpCode = 0;
+};
+
+// --- CONNECTION CACHE ---
+// One keep-alive HTTPS connection per fetch task, so consecutive sources on
+// the same host (most are news.google.com) skip the TCP + TLS handshake. It
+// is only kept once the last response has been read to its end. Whoever
+// fetches allocates it on the heap: the body reader and item (~3 KB between
+// them) would otherwise sit on a task stack that the TLS handshake needs.
+struct FetchConnection {
+  WiFiClientSecure client;
+  String host;         // host[:port] the client is (or was last) connected to
+  FeedInflater* inflater = NULL;   // Taken on first use if the heap allows
+  FeedReader reader;
+  FeedItem item;       // Fixed-size fields, reused for every item
+  ~FetchConnection() { freeFeedInflater(inflater); }
+};
+
+// --- FEED REQUESTS ---
+// Requests are written here rather than through HTTPClient: it always sends
+// its own "Accept-Encoding: identity;q=1,chunked;q=0.1,*;q=0" line, so a
+// gzip offer could only go out as a second header contradicting the first.
+// Only what fetchSource needs is parsed from the reply; the body is left
+// on the client for FeedReader.
+#define FETCH_ERR_CONNECT  -1   // No connection (DNS, TCP or TLS)
+#define FETCH_ERR_SEND     -2   // The request couldn't be written
+#define FETCH_ERR_REPLY    -3   // No complete status line and headers in time
+#define FETCH_HEAD_TIMEOUT_MS 5000
+#define FETCH_REDIRECTS_MAX   5
+#define FETCH_LINE_MAX        512   // Longer header lines are cut; only their start is used
+
+struct FeedResponse {
+  int code = 0;
+  long contentLength = -1;   // -1: not sent (chunked, or until the server closes)
+  bool chunked = false;
+  bool keepAlive = true;     // HTTP/1.1 keeps the connection unless told to close
+  String etag, lastModified, contentEncoding, location;
+};
+
+// https://host[:port]/path into its parts; false for anything else
+static bool splitUrl(const String& url, String& host, String& path) {
+  if (!url.startsWith("https://")) return false;
+  int slash = url.indexOf('/', 8);
+  host = (slash < 0) ? url.substring(8) : url.substring(8, slash);
+  path = (slash < 0) ? String("/") : url.substring(slash);
+  return host.length() > 0;
+}
+
+// A connection for conn.host, reusing the open one; false if it can't be had
+static bool connectFeedHost(FetchConnection& conn, FetchSlot& slot) {
+  if (conn.client.connected()) return true;
+  conn.client.stop();
+  int colon = conn.host.indexOf(':');
+  String name = (colon < 0) ? conn.host : conn.host.substring(0, colon);
+  uint16_t port = (colon < 0) ? 443 : conn.host.substring(colon + 1).toInt();
+  if (!conn.client.connect(name.c_str(), port)) return false;
+  slot.handshakes++;
+  return true;
+}
+
+// One line without its CRLF; false if the head runs past FETCH_HEAD_TIMEOUT_MS from start
+static bool readHeadLine(WiFiClient& client, String& line, unsigned long start) {
+  line = "";
+  while (millis() - start < FETCH_HEAD_TIMEOUT_MS) {
+    int c = client.read();   // A byte at a time, so none of the body is taken
+    if (c < 0) {
+      if (!client.connected()) return false;
+      delay(1);
+      continue;
+    }
+    if (c == '\n') {
+      if (line.endsWith("\r")) line.remove(line.length() - 1);
+      return true;
+    }
+    if (line.length() < FETCH_LINE_MAX) line += (char)c;
+  }
+  return false;
+}
+
+static bool sendFeedRequest(FetchConnection& conn, const String& path, const String& extraHeaders) {
+  String req = "GET " + path + " HTTP/1.1\r\nHost: " + conn.host +
+               "\r\nUser-Agent: Mozilla/5.0 (ESP32)\r\nConnection: keep-alive\r\n";
+  // Compressed feeds spend far less time on the air; inflating needs a
+  // 32 KB window though, so gzip is only offered while an inflater is held
+  req += conn.inflater ? "Accept-Encoding: gzip, identity;q=0.5\r\n" : "Accept-Encoding: identity\r\n";
+  req += extraHeaders;
+  req += "\r\n";
+  return conn.client.write((const uint8_t*)req.c_str(), req.length()) == req.length();
+}
+
+static int readFeedResponse(WiFiClient& client, FeedResponse& res) {
+  res = FeedResponse();
+  unsigned long start = millis();
+  String line;
+  // "HTTP/1.1 200 OK"
+  if (!readHeadLine(client, line, start) || !line.startsWith("HTTP/1.") || line.length() < 12) return FETCH_ERR_REPLY;
+  res.code = line.substring(9, 12).toInt();
+  res.keepAlive = (line[7] != '0');
+  while (readHeadLine(client, line, start)) {
+    if (line.length() == 0) return res.code;
+    int colon = line.indexOf(':');
+    if (colon <= 0) continue;
+    String name = line.substring(0, colon);
+    String value = line.substring(colon + 1);
+    value.trim();
+    if (name.equalsIgnoreCase("Content-Length")) res.contentLength = value.toInt();
+    else if (name.equalsIgnoreCase("Transfer-Encoding")) res.chunked = value.equalsIgnoreCase("chunked");
+    else if (name.equalsIgnoreCase("Connection")) res.keepAlive = !value.equalsIgnoreCase("close");
+    else if (name.equalsIgnoreCase("ETag")) res.etag = value;
+    else if (name.equalsIgnoreCase("Last-Modified")) res.lastModified = value;
+    else if (name.equalsIgnoreCase("Content-Encoding")) res.contentEncoding = value;
+    else if (name.equalsIgnoreCase("Location")) res.location = value;
+  }
+  return FETCH_ERR_REPLY;
+}
+
+// Sends GET url on conn and reads the reply head, following redirects the
+// way HTTPClient's strict mode did. Returns the status, or a negative
+// FETCH_ERR_*; a 200's body is left on conn.client.
+static int getFeed(FetchConnection& conn, String url, const String& extraHeaders, FeedResponse& res, FetchSlot& slot) {
+  for (int hop = 0; hop <= FETCH_REDIRECTS_MAX; hop++) {
+    String host, path;
+    if (!splitUrl(url, host, path)) return FETCH_ERR_CONNECT;
+    // A connection to another host can't carry this request
+    if (host != conn.host) {
+      conn.client.stop();
+      conn.host = host;
+    }
+    bool reused = conn.client.connected();
+    if (hop == 0) slot.reused = reused;
+    if (!connectFeedHost(conn, slot)) return FETCH_ERR_CONNECT;
+    int code = sendFeedRequest(conn, path, extraHeaders) ? readFeedResponse(conn.client, res) : FETCH_ERR_SEND;
+    if (code < 0 && reused) {
+      // The server dropped the idle connection; start a fresh one
+      Serial.println("[NewsCore] Kept connection closed. Reconnecting.");
+      conn.client.stop();
+      if (hop == 0) slot.reused = false;
+      if (!connectFeedHost(conn, slot)) return FETCH_ERR_CONNECT;
+      code = sendFeedRequest(conn, path, extraHeaders) ? readFeedResponse(conn.client, res) : FETCH_ERR_SEND;
+    }
+    bool redirect = (code == 301 || code == 302 || code == 303 || code == 307 || code == 308);
+    if (!redirect || res.location == "" || hop == FETCH_REDIRECTS_MAX) return code;
+    url = res.location.startsWith("/") ? "https://" + conn.host + res.location : res.location;
+    if (!splitUrl(url, host, path)) return code;   // Off HTTPS: not followed
+
+    // Read off the redirect's body so the connection can carry the next hop
+    conn.reader.begin(&conn.client, res.chunked, res.chunked ? -1 : res.contentLength);
+    if (!res.keepAlive || !conn.reader.drain(KEEPALIVE_DRAIN_BYTES, slot.drained)) conn.client.stop();
+    Serial.print("[NewsCore] Redirected to: "); Serial.println(url);
+  }
+  return FETCH_ERR_CONNECT;   // Not reached
+}
+
+static uint32_t digestText(const char* text, uint32_t h = 2166136261UL) {
+  for (; *text; text++) { h ^= (uint8_t)*text; h *= 16777619UL; }
+  return h;
+}
+
+// Fetches one source into its slot (the pool itself is only touched by
+// commitNewsRefresh). Returns false when the source couldn't be read.
+bool fetchSource(int sourceIdx, FetchSlot& slot, FetchConnection& conn) {
+  std::vector<Story>& out = slot.stories;
   esp_task_wdt_reset();
   Serial.println("\n========================================");
   Serial.print("[NewsCore] Fetching: ");
@@ -746,107 +894,160 @@ void fetchAndPool(int sourceIdx) {
   }
   #endif
   
-  // Skip sources that have failed too many times in a row
-  if (sourceStats[sourceIdx].consecutiveFails > 2) {
-      Serial.print("[NewsCore] SKIP - Source too unreliable (failures: ");
-      Serial.print(sourceStats[sourceIdx].consecutiveFails);
-      Serial.println(")");
-      return;
-  }
-  
   // Per-source tracking
   sourceStats[sourceIdx].lastFetchMs = millis();
   
   // Heap Guard
   if (ESP.getFreeHeap() < 20000) {
       Serial.println("[NewsCore] Low Heap (<20k). Skipping fetch.");
-      return;
+      return true;
   }
 
+  // The pool only changes at commit, after every worker is done, so reading it here is safe
   if (megaPool.size() >= MAX_POOL_SIZE) {
       Serial.println("[NewsCore] Max Pool Size Reached. Stopping fetch.");
-      return;
+      return true;
   }
 
-  WiFiClientSecure client;
+  bool ok = true;
+  slot.phase = FETCH_CONNECTING;
+
+  // Validators are only worth sending while the pool still holds this
+  // source's stories for a 304 to keep
+  SourceStats& st = sourceStats[sourceIdx];
+  // A half-open probe finds out quickly whether a slow source has recovered
+  unsigned long fetchTimeoutMs = (st.breaker == BREAKER_HALF_OPEN) ? BREAKER_PROBE_TIMEOUT_MS : SOURCE_FETCH_TIMEOUT_MS;
+  bool canReuse = false;
+  for (const auto& s : megaPool) {
+      if (s.sourceIndex == sourceIdx) { canReuse = true; break; }
+  }
+
+  bool atBoundary = false;   // Response read to its end: the connection can stay open
+
+  WiFiClientSecure& client = conn.client;
   client.setInsecure();
   client.setTimeout(5000); 
-  HTTPClient http;
-  http.setUserAgent("Mozilla/5.0 (ESP32)");
-  http.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
+  String host, path;
   
-  if (http.begin(client, sources[sourceIdx].url)) {
+  if (splitUrl(sources[sourceIdx].url, host, path)) {
+    // Inflating needs a 32 KB window, so gzip is only offered while the
+    // heap can spare one; the reply's Content-Encoding decides
+    if (!conn.inflater && ESP.getMaxAllocHeap() > FEED_GZIP_MIN_HEAP) conn.inflater = newFeedInflater();
+    String conditional;
+    if (canReuse) {
+        if (st.etag != "") conditional += "If-None-Match: " + st.etag + "\r\n";
+        if (st.lastModified != "") conditional += "If-Modified-Since: " + st.lastModified + "\r\n";
+    }
     esp_task_wdt_reset(); 
-    int httpCode = http.GET();
+    FeedResponse res;
+    int httpCode = getFeed(conn, sources[sourceIdx].url, conditional, res, slot);
     esp_task_wdt_reset();
+    if (slot.reused) Serial.println("[NewsCore] Reused keep-alive connection.");
     
     Serial.print("[DEBUG] HTTP Code: "); Serial.println(httpCode);
+    if (httpCode > 0) st.checks++;
+    slot.httpCode = httpCode;
     
-    if (httpCode == HTTP_CODE_OK) {
-      WiFiClient *stream = http.getStreamPtr();
-      if (!stream) {
-          Serial.println("[ERROR] Failed to get stream pointer");
-          lastSyncFailed = true;
-          http.end();
-          return;
+    if (httpCode == 304 && canReuse) {
+      Serial.println("[NewsCore] Not modified. Keeping pooled stories.");
+      slot.unchanged = true;
+      slot.outcome = OUTCOME_OK;
+      st.unchanged++;
+      st.consecutiveFails = 0;
+      atBoundary = res.keepAlive;   // A 304 has no body
+    } else if (httpCode == 200) {
+      slot.phase = FETCH_PARSING;
+      // Validators only count once this body has been read through
+      String etag = res.etag;
+      String lastModified = res.lastModified;
+      bool useDigest = (etag == "" && lastModified == "");
+      uint32_t itemDigest = 0;
+      WiFiClient *stream = &client;
+      String encodingName = res.contentEncoding;
+      FeedEncoding encoding = FEED_IDENTITY;
+      bool decodable = true;
+      if (encodingName.equalsIgnoreCase("gzip") || encodingName.equalsIgnoreCase("x-gzip")) encoding = FEED_GZIP;
+      else if (encodingName.equalsIgnoreCase("deflate")) encoding = FEED_DEFLATE;
+      else if (encodingName != "" && !encodingName.equalsIgnoreCase("identity")) decodable = false;
+      if (!decodable || (encoding != FEED_IDENTITY && !conn.inflater)) {
+          Serial.print("[ERROR] Can't decode Content-Encoding: "); Serial.println(encodingName);
+          slot.outcome = OUTCOME_PARSE_ERROR;
+          client.stop();
+          sourceStats[sourceIdx].lastDurationMs = millis() - sourceStats[sourceIdx].lastFetchMs;
+          return false;
       }
+      slot.compressed = (encoding != FEED_IDENTITY);
       int storiesFound = 0;
       int itemsProcessed = 0;
       int consecutiveParseFailures = 0;
+      bool gaveUp = false;      // Stopped on bad items (or our own low heap), not the stream
+      bool lowHeap = false;
       unsigned long sourceStart = millis();
       
-      // Pre-build dedup set for this source (O(n) once, not O(n²) per item)
+      // Dedup set for this source; its old stories were dropped before the batch
       std::set<String> existingHeadlines;
-      for(const auto& s : megaPool) {
-          if (s.sourceIndex == sourceIdx) {
-              existingHeadlines.insert(s.headline);
-          }
-      }
+      // getStreamPtr() hands back the raw body, chunk framing and all
+      FeedReader& reader = conn.reader;
+      reader.begin(stream, res.chunked, res.chunked ? -1 : res.contentLength,
+                   encoding, conn.inflater);
+      FeedItem& item = conn.item;
       
-      while(storiesFound < FETCH_LIMIT_PER_SRC && (millis() - sourceStart) < SOURCE_FETCH_TIMEOUT_MS) {
+      while(storiesFound < FETCH_LIMIT_PER_SRC && (millis() - sourceStart) < fetchTimeoutMs) {
         
-        if (safeFind(stream, "<item>")) {
+        if (reader.find("<item>")) {
            itemsProcessed++;
            sourceStats[sourceIdx].fetched++;
            String tempTitle = "", tempDate = "", tempLink = "", tempDesc = "", tempContent = "";
            bool isWp = sources[sourceIdx].isWordpress;
-           // WordPress sources have large content blocks; increase buffer for full extraction
-           int itemMaxLen = isWp ? 4000 : 1500;
-           String itemXml = safeReadUntilEndTagWithTimeout(stream, "</item>", itemMaxLen, ITEM_PARSE_TIMEOUT_MS);
-           if (itemXml == "") {
+           if (!reader.readItem(item, ITEM_PARSE_TIMEOUT_MS)) {
                Serial.print("[DEBUG] Item #"); Serial.print(itemsProcessed); Serial.println(" - Parse timeout");
                sourceStats[sourceIdx].parseErrors++;
                sourceStats[sourceIdx].consecutiveFails++;
                continue;
            }
            
-           Serial.print("[DEBUG] Item #"); Serial.print(itemsProcessed); Serial.print(" XML len: "); Serial.println(itemXml.length());
+           Serial.print("[DEBUG] Item #"); Serial.print(itemsProcessed); Serial.print(" fields: "); Serial.print((int)item.seen);
+           Serial.print(" truncated: "); Serial.println((int)item.truncated);
+
+           // No validators from the server: an identical first item means an unchanged feed
+           if (useDigest && itemsProcessed == 1) {
+               uint32_t digest = digestText(item.pubDate, digestText(item.link, digestText(item.title)));
+               if (canReuse && digest == st.itemDigest) {
+                   Serial.println("[NewsCore] First item unchanged. Keeping pooled stories.");
+                   slot.unchanged = true;
+                   st.unchanged++;
+                   st.consecutiveFails = 0;
+                   break;
+               }
+               itemDigest = digest;
+           }
 
-           tempTitle = extractTagValue(itemXml, "<title>", "</title>");
-           tempLink = extractTagValue(itemXml, "<link>", "</link>");
-           tempDate = extractTagValue(itemXml, "<pubDate>", "</pubDate>");
+           if (!(item.seen & FEED_TITLE)) Serial.println("[WARN] Missing tag: <title>");
+           if (!(item.seen & FEED_LINK)) Serial.println("[WARN] Missing tag: <link>");
+           if (!(item.seen & FEED_PUBDATE)) Serial.println("[WARN] Missing tag: <pubDate>");
+           tempTitle = item.title;
+           tempLink = item.link;
+           tempDate = item.pubDate;
+           // Permalink guids stand in for a missing link
+           if (tempLink == "" && strncmp(item.guid, "http", 4) == 0) tempLink = item.guid;
 
            Serial.print("[DEBUG]   Title: "); Serial.println(tempTitle.length() > 50 ? tempTitle.substring(0, 50) + "..." : tempTitle);
            Serial.print("[DEBUG]   Link: "); Serial.println(tempLink.length() > 50 ? tempLink.substring(0, 50) + "..." : tempLink);
            Serial.print("[DEBUG]   Date: "); Serial.println(tempDate);
+           if (item.source[0]) { Serial.print("[DEBUG]   Source: "); Serial.println(item.source); }
 
+           // The tokenizer already dropped CDATA wrappers and cut content:encoded short
            if (isWp) {
-               tempDesc = extractTagValue(itemXml, "<description>", "</description>");
-               tempContent = extractTagValue(itemXml, "<content:encoded>", "</content:encoded>");
-               if (tempContent.length() > 200) tempContent = tempContent.substring(0, 200);
+               tempDesc = item.description;
+               tempContent = item.content;
            }
 
-           tempTitle.replace("<![CDATA[", ""); tempTitle.replace("]]>", "");
-           tempLink.replace("<![CDATA[", ""); tempLink.replace("]]>", "");
-           tempDate.replace("<![CDATA[", ""); tempDate.replace("]]>", "");
            if (tempDesc != "") {
-               tempDesc.replace("<![CDATA[", ""); tempDesc.replace("]]>", "");
                tempDesc = stripWpMediaTags(tempDesc);
                tempDesc = stripAllHtmlTags(tempDesc);
                tempDesc = cleanText(tempDesc);
            }
            if (tempContent != "") {
-               tempContent.replace("<![CDATA[", ""); tempContent.replace("]]>", "");
                tempContent = stripWpMediaTags(tempContent);
                tempContent = stripAllHtmlTags(tempContent);
                tempContent = cleanText(tempContent);
@@ -915,13 +1116,13 @@ void fetchAndPool(int sourceIdx) {
                
                s.timeStr = formatTime(s.timestamp);
                s.sourceIndex = sourceIdx;
-               megaPool.push_back(s);
+               layoutHeadline(s);
                existingHeadlines.insert(s.headline);
+               out.push_back(s);
                storiesFound++;
+               slot.found = storiesFound;
                sourceStats[sourceIdx].accepted++;
                Serial.print("[DEBUG]   ACCEPTED! Stories from this source: "); Serial.println(storiesFound);
-               
-               if (megaPool.size() >= MAX_POOL_SIZE) break;
            } else {
                Serial.println("[DEBUG]   REJECTED: No title");
                consecutiveParseFailures++;
@@ -931,22 +1132,48 @@ void fetchAndPool(int sourceIdx) {
            
            if (consecutiveParseFailures > 3) {
                Serial.println("[DEBUG] Too many parse failures. Aborting source.");
+               gaveUp = true;
                break;
            }
            
            if (ESP.getFreeHeap() < 15000) {
                Serial.println("[DEBUG] Low heap during fetch. Aborting source.");
+               gaveUp = lowHeap = true;
                break;
            }
            
            esp_task_wdt_reset();
         } else { break; }
       }
+
+      slot.received = reader.received();
+      slot.decoded = reader.decoded();
+      bool timedOut = (millis() - sourceStart) >= fetchTimeoutMs;
+      if (storiesFound > 0 || slot.unchanged) slot.outcome = OUTCOME_OK;
+      else if (lowHeap) slot.outcome = OUTCOME_SKIPPED;
+      else if (timedOut || !(reader.ended() || gaveUp)) slot.outcome = OUTCOME_TIMEOUT;   // Stalled
+      else slot.outcome = OUTCOME_PARSE_ERROR;
+      // Only a complete read swaps the source's stories and validators. A
+      // cut-short one is dropped while the pool still holds the last full
+      // set (whose validators stay), and only fills an empty one, with no
+      // validators, since a 304 against those would pin the partial set
+      if (!slot.unchanged && slot.outcome == OUTCOME_OK) {
+          bool complete = reader.ended() || storiesFound >= FETCH_LIMIT_PER_SRC;
+          slot.replaces = complete || !canReuse;
+          if (slot.replaces) {
+              st.etag = complete ? etag : String();
+              st.lastModified = complete ? lastModified : String();
+              st.itemDigest = complete ? itemDigest : 0;
+          }
+          if (!slot.replaces) Serial.println("[NewsCore] Read cut short. Keeping pooled stories.");
+      }
+
+      // Reading on to the end is cheaper than a new handshake, up to a point
+      atBoundary = reader.drain(KEEPALIVE_DRAIN_BYTES, slot.drained) && res.keepAlive;
       
       Serial.println("\n--- Source Fetch Complete ---");
       Serial.print("[NewsCore] Items processed: "); Serial.println(itemsProcessed);
       Serial.print("[NewsCore] Stories added: "); Serial.println(storiesFound);
-      Serial.print("[NewsCore] Total pool size now: "); Serial.println(megaPool.size());
       #ifdef DEBUG_MODE
       if (DEBUG_MODE) {
         Serial.print("[DEBUG] Final free heap: "); Serial.println(ESP.getFreeHeap());
@@ -958,35 +1185,276 @@ void fetchAndPool(int sourceIdx) {
       #endif
       Serial.println("========================================\n");
       
-      if ((millis() - sourceStart) >= SOURCE_FETCH_TIMEOUT_MS) {
+      if (timedOut) {
                     Serial.println("[NewsCore] Source fetch timeout.");
             }
     } else {
         Serial.print("HTTP Error: "); Serial.println(httpCode);
-        lastSyncFailed = true; 
+        // Negative codes are FETCH_ERR_*: no connection or no reply in time
+        slot.outcome = (httpCode < 0) ? OUTCOME_TIMEOUT : OUTCOME_HTTP_ERROR;
+        ok = false;
         sourceStats[sourceIdx].parseErrors++;
         sourceStats[sourceIdx].consecutiveFails++;
     }
-    http.end();
+    if (!atBoundary) client.stop();
   } else {
       Serial.println("Connection Failed.");
-      lastSyncFailed = true;
+      slot.outcome = OUTCOME_HTTP_ERROR;   // Only https:// URLs can be fetched
+      ok = false;
       sourceStats[sourceIdx].parseErrors++;
       sourceStats[sourceIdx].consecutiveFails++;
   }
+  sourceStats[sourceIdx].lastDurationMs = millis() - sourceStats[sourceIdx].lastFetchMs;
+  return ok;
+}
+
+// --- BACKGROUND REFRESH ---
+// A batch moves IDLE -> FETCHING -> READY -> (commit) -> IDLE. Worker tasks
+// pull sources of the batch off a queue and fetch each with its own client
+// into that source's slot, so a batch takes about as long as its slowest
+// source while loop() keeps running. Only the commit touches megaPool, and it
+// runs on the loop task once nothing on screen is mid-transition.
+struct RefreshJob {
+  int sources[6];                // Picked by planNewsRefresh
+  int count = 0;
+  int workers = 0;               // Tasks started for this batch
+  int finished = 0;              // Tasks that have exited
+  unsigned long startedMs = 0;
+#if FETCH_CONCURRENCY > 0
+  QueueHandle_t todo = NULL;     // Offsets into the batch still to fetch
+  SemaphoreHandle_t done = NULL; // Given once by each worker as it exits
+  unsigned long retryMs = 0;     // Last attempt to start workers
+#endif
+};
+static FetchSlot fetchSlots[6];
+static RefreshJob refreshJob;
+static RefreshState refreshState = REFRESH_IDLE;
+
+static void fetchSlot(int offset, FetchConnection& conn) {
+  FetchSlot& slot = fetchSlots[offset];
+  slot.ok = fetchSource(refreshJob.sources[offset], slot, conn);
+  slot.phase = FETCH_DONE;
+}
+
+#if FETCH_CONCURRENCY > 0
+static void fetchWorker(void* arg) {
+  // Watched like the loop task: a fetch that hangs past WDT_TIMEOUT_SECONDS
+  // resets the board instead of leaving the batch FETCHING for good
+  esp_task_wdt_add(NULL);
+  // Without a connection the worker takes nothing; any slot no worker
+  // reaches is failed once they have all exited
+  FetchConnection* conn = new (std::nothrow) FetchConnection;
+  if (!conn) Serial.println("[ERROR] No heap for a fetch connection");
+  int offset;
+  while (conn && xQueueReceive(refreshJob.todo, &offset, 0) == pdTRUE) {
+    fetchSlot(offset, *conn);
+    esp_task_wdt_reset();
+  }
+  delete conn;   // vTaskDelete doesn't return, so the connection closes here
+  esp_task_wdt_delete(NULL);
+  xSemaphoreGive(refreshJob.done);
+  vTaskDelete(NULL);
+}
+
+// Every TLS session in flight needs its own buffers, so back off on a tight heap
+static int fetchWorkerCount() {
+  int n = FETCH_CONCURRENCY;
+  while (n > 1 && ESP.getFreeHeap() < (uint32_t)n * FETCH_WORKER_HEAP) n--;
+  return n;
+}
+
+static void queueFetchBatch(int count) {
+  refreshJob.todo = xQueueCreate(count, sizeof(int));
+  refreshJob.done = xSemaphoreCreateCounting(FETCH_CONCURRENCY, 0);
+  for (int i = 0; i < count; i++) xQueueSend(refreshJob.todo, &i, 0);
+}
+
+// Returns the number of tasks started; 0 leaves the whole batch queued
+static int startFetchWorkers() {
+  int workers = fetchWorkerCount();
+  refreshJob.retryMs = millis();
+  int started = 0;
+  for (int w = 0; w < workers; w++) {
+    if (xTaskCreatePinnedToCore(fetchWorker, "fetch", FETCH_WORKER_STACK, NULL, 1, NULL, 1) == pdPASS) started++;
+  }
+  return started;
+}
+
+static void stopFetchWorkers() {
+  vQueueDelete(refreshJob.todo);
+  vSemaphoreDelete(refreshJob.done);
+  refreshJob.todo = NULL;
+  refreshJob.done = NULL;
+}
+#endif
+
+// --- SCHEDULER ---
+// A source is due again once it should have SOURCE_TARGET_NEW stories the
+// pool hasn't seen, going by an EWMA of its new-story rate. Each wake-up
+// takes the most overdue sources, within a request budget that refills at
+// REFRESH_BUDGET_PER_HOUR. Sources never read go first and cost nothing,
+// so the first pass fills the pool as the old rotation did.
+static float requestBudget = 6;
+static unsigned long budgetAtMs = 0;
+
+static void refillRequestBudget() {
+  unsigned long now = millis();
+  requestBudget += (now - budgetAtMs) * (float)REFRESH_BUDGET_PER_HOUR / 3600000.0f;
+  if (requestBudget > 6) requestBudget = 6;
+  budgetAtMs = now;
+}
+
+// --- CIRCUIT BREAKER ---
+// CLOSED reads normally and counts consecutive failures by kind; enough of
+// one kind opens it. OPEN keeps the source out of every batch for a period
+// that doubles with each failed probe (jittered, so sources that failed
+// together don't come back together). After that the scheduler can take it
+// as a HALF_OPEN probe with a shorter time limit: success closes it, any
+// failure opens it again. Device-side skips and WiFi outages don't count.
+static const char* breakerName(uint8_t state) {
+  if (state == BREAKER_OPEN) return "OPEN";
+  if (state == BREAKER_HALF_OPEN) return "HALF-OPEN";
+  return "CLOSED";
+}
+
+static const char* outcomeName(uint8_t outcome) {
+  switch (outcome) {
+    case OUTCOME_TIMEOUT: return "timeouts";
+    case OUTCOME_HTTP_ERROR: return "HTTP errors";
+    case OUTCOME_PARSE_ERROR: return "no usable stories";
+    default: return "ok";
+  }
+}
+
+static void updateBreaker(int src, const FetchSlot& slot) {
+  SourceStats& st = sourceStats[src];
+  uint8_t outcome = slot.outcome;
+  // With the network down every source times out; that says nothing about any of them
+  if (outcome == OUTCOME_TIMEOUT && WiFi.status() != WL_CONNECTED) outcome = OUTCOME_SKIPPED;
+  if (outcome == OUTCOME_SKIPPED) return;
+
+  if (outcome == OUTCOME_OK) {
+      if (st.breaker != BREAKER_CLOSED) {
+          Serial.print("[NewsCore] Breaker closed: "); Serial.println(sources[src].name);
+      }
+      st.breaker = BREAKER_CLOSED;
+      st.timeouts = st.httpErrors = st.parseFails = 0;
+      st.reopens = 0;
+      return;
+  }
+
+  int count, trips;
+  unsigned long baseMs;
+  if (outcome == OUTCOME_TIMEOUT) {
+      count = ++st.timeouts;
+      trips = BREAKER_TIMEOUT_TRIPS;
+      baseMs = BREAKER_TIMEOUT_MS;
+  } else if (outcome == OUTCOME_HTTP_ERROR) {
+      count = ++st.httpErrors;
+      // A 4xx other than 408 / 429 won't go away by asking again soon
+      bool lasting = slot.httpCode >= 400 && slot.httpCode < 500 && slot.httpCode != 408 && slot.httpCode != 429;
+      trips = lasting ? 1 : BREAKER_HTTP_TRIPS;
+      baseMs = BREAKER_HTTP_MS;
+  } else {
+      count = ++st.parseFails;
+      trips = BREAKER_PARSE_TRIPS;
+      baseMs = BREAKER_PARSE_MS;
+  }
+  if (st.breaker == BREAKER_CLOSED && count < trips) return;
+
+  if (st.breaker == BREAKER_HALF_OPEN && st.reopens < 255) st.reopens++;
+  unsigned long periodMs = min(baseMs << min((int)st.reopens, 6), (unsigned long)BREAKER_MAX_MS);
+  long jitter = (long)(periodMs / 100 * BREAKER_JITTER_PCT);
+  periodMs += random(-jitter, jitter + 1);
+  st.breaker = BREAKER_OPEN;
+  st.openedBy = outcome;
+  st.openUntilMs = millis() + periodMs;
+  st.opens++;
+  Serial.print("[NewsCore] Breaker open: "); Serial.print(sources[src].name);
+  Serial.print(" ("); Serial.print(outcomeName(outcome)); Serial.print(") for ");
+  Serial.print(periodMs / 60000); Serial.println(" min");
+}
+
+// Folds a committed read into the source's breaker and rate, and sets when
+// it's next due
+static void scheduleSource(int src, int newStories, const FetchSlot& slot) {
+  SourceStats& st = sourceStats[src];
+  unsigned long now = millis();
+  updateBreaker(src, slot);
+  if (st.breaker == BREAKER_OPEN) {
+      st.nextDueMs = st.openUntilMs;
+      return;
+  }
+  if (slot.outcome != OUTCOME_OK) {
+      // Nothing learned; try again soon
+      st.nextDueMs = now + SOURCE_MIN_INTERVAL_MS;
+      return;
+  }
+  st.lastNew = newStories;
+  if (st.sampledMs == 0) {
+      st.newPerHour = SOURCE_TARGET_NEW;   // No history: about hourly, like the rotation
+  } else {
+      float hours = max((now - st.sampledMs) / 3600000.0f, 0.05f);
+      st.newPerHour += SOURCE_RATE_SMOOTHING * (newStories / hours - st.newPerHour);
+  }
+  st.sampledMs = now;
+  float intervalMs = 3600000.0f * SOURCE_TARGET_NEW / max(st.newPerHour, 0.01f);
+  st.nextDueMs = now + (unsigned long)constrain(intervalMs, (float)SOURCE_MIN_INTERVAL_MS, (float)SOURCE_MAX_INTERVAL_MS);
 }
 
-void refreshNewsData(int batchIndex) {
+int planNewsRefresh(bool force) {
+  if (refreshState != REFRESH_IDLE) return 0;
+  refillRequestBudget();
+  unsigned long now = millis();
+  int budget = force ? 6 : (int)requestBudget;
+  int paid = 0;
+  bool taken[30] = {false};
+  refreshJob.count = 0;
+  while (refreshJob.count < 6) {
+      int best = -1;
+      long bestLate = 0;
+      for (int i = 0; i < 30; i++) {
+          if (taken[i]) continue;
+          // An open breaker holds the source back, even from a forced refresh
+          if (sourceStats[i].breaker == BREAKER_OPEN && (long)(now - sourceStats[i].openUntilMs) < 0) continue;
+          bool fresh = (sourceStats[i].nextDueMs == 0);
+          if (!fresh && paid >= budget) continue;
+          long late = fresh ? LONG_MAX - i : (long)(now - sourceStats[i].nextDueMs);
+          if (late < 0 && !force) continue;
+          if (best < 0 || late > bestLate) { best = i; bestLate = late; }
+      }
+      if (best < 0) break;
+      taken[best] = true;
+      if (sourceStats[best].nextDueMs != 0) paid++;
+      refreshJob.sources[refreshJob.count++] = best;
+  }
+  if (refreshJob.count == 0) {
+      Serial.print("[NewsCore] No sources due (budget "); Serial.print(requestBudget, 1); Serial.println(")");
+  }
+  return refreshJob.count;
+}
+
+bool startNewsRefresh() {
+  if (refreshState != REFRESH_IDLE || refreshJob.count == 0) return false;
+
   #ifdef OFFLINE_MODE
-  if (OFFLINE_MODE) { return; }
+  if (OFFLINE_MODE) { return false; }
   #endif
 
+  int count = refreshJob.count;
   Serial.println("\n\n##########################################");
   Serial.println("###  NEWS REFRESH CYCLE STARTING      ###");
   Serial.println("##########################################");
-  Serial.print("[NewsCore] Batch Index: "); Serial.println(batchIndex);
-  Serial.print("[NewsCore] Batch Range: Sources "); 
-  Serial.print(batchIndex * 6); Serial.print(" - "); Serial.println((batchIndex * 6) + 5);
+  Serial.print("[NewsCore] Due Sources: "); Serial.print(count);
+  Serial.print(" (budget "); Serial.print(requestBudget, 1); Serial.println(")");
+  for (int i = 0; i < count; i++) {
+      int src = refreshJob.sources[i];
+      Serial.print("[NewsCore]   "); Serial.print(src); Serial.print(" - "); Serial.print(sources[src].name);
+      if (sourceStats[src].nextDueMs == 0) { Serial.println(" (first read)"); continue; }
+      if (sourceStats[src].breaker == BREAKER_OPEN) { Serial.println(" (breaker probe)"); continue; }
+      Serial.print(" ("); Serial.print(sourceStats[src].newPerHour, 2); Serial.print(" new/h, ");
+      Serial.print((long)(millis() - sourceStats[src].nextDueMs) / 60000); Serial.println(" min overdue)");
+  }
   
   #ifdef DEBUG_MODE
   if (DEBUG_MODE) {
@@ -1001,17 +1469,13 @@ void refreshNewsData(int batchIndex) {
   #endif
   
   // Reset stats for this batch
-  int start = batchIndex * 6;
-  int end = start + 6;
-  for(int i = start; i < end; i++) {
-      sourceStats[i].fetched = 0;
-      sourceStats[i].accepted = 0;
-      sourceStats[i].duplicates = 0;
-      sourceStats[i].parseErrors = 0;
+  for(int i = 0; i < count; i++) {
+      int src = refreshJob.sources[i];
+      sourceStats[src].fetched = 0;
+      sourceStats[src].accepted = 0;
+      sourceStats[src].duplicates = 0;
+      sourceStats[src].parseErrors = 0;
   }
-  
-  
-  if (megaPool.capacity() < 100) megaPool.reserve(100);
 
   esp_task_wdt_reset();
   lastSyncFailed = false;
@@ -1025,21 +1489,149 @@ void refreshNewsData(int batchIndex) {
       Serial.println("[NewsCore] WiFi Failure. Aborting.");
       lastSyncFailed = true; 
       failureCount++;
+      refreshJob.count = 0;
       // Nuclear Option: Reboot after 4 failures
       if (failureCount >= 4) ESP.restart(); 
-      return; 
+      return false; 
+  }
+
+  // Only a batch that goes out pays for its requests and probes open breakers
+  int paid = 0;
+  for (int i = 0; i < count; i++) {
+      SourceStats& st = sourceStats[refreshJob.sources[i]];
+      if (st.breaker == BREAKER_OPEN) st.breaker = BREAKER_HALF_OPEN;
+      if (st.nextDueMs != 0) paid++;
+  }
+  requestBudget = max(requestBudget - paid, 0.0f);
+
+  for (int i = 0; i < count; i++) {
+      fetchSlots[i].stories.clear();
+      fetchSlots[i].phase = FETCH_QUEUED;
+      fetchSlots[i].found = 0;
+      fetchSlots[i].ok = true;
+      fetchSlots[i].unchanged = false;
+      fetchSlots[i].replaces = false;
+      fetchSlots[i].handshakes = 0;
+      fetchSlots[i].reused = false;
+      fetchSlots[i].drained = 0;
+      fetchSlots[i].received = 0;
+      fetchSlots[i].decoded = 0;
+      fetchSlots[i].compressed = false;
+      fetchSlots[i].outcome = OUTCOME_SKIPPED;
+      fetchSlots[i].httpCode = 0;
+  }
+  refreshJob.workers = 0;
+  refreshJob.finished = 0;
+  refreshJob.startedMs = millis();
+  refreshState = REFRESH_FETCHING;
+
+#if FETCH_CONCURRENCY > 0
+  // With no task to be had, the batch waits for stepNewsRefresh to retry
+  queueFetchBatch(count);
+  refreshJob.workers = startFetchWorkers();
+  if (refreshJob.workers == 0) Serial.println("[NewsCore] No fetch task could start. Retrying.");
+  return true;
+#else
+  // None configured: fetch the batch right here, blocking the loop. The
+  // connection goes on the heap; the loop task's stack is 8 KB.
+  FetchConnection* conn = new (std::nothrow) FetchConnection;
+  for (int i = 0; i < count; i++) {
+     if (conn) fetchSlot(i, *conn);
+     else { fetchSlots[i].ok = false; fetchSlots[i].phase = FETCH_DONE; }
+     esp_task_wdt_reset();
+  }
+  if (!conn) Serial.println("[ERROR] No heap for a fetch connection");
+  delete conn;
+  refreshState = REFRESH_READY;
+  return true;
+#endif
+}
+
+RefreshState stepNewsRefresh() {
+#if FETCH_CONCURRENCY > 0
+  if (refreshState == REFRESH_FETCHING) {
+      if (refreshJob.workers == 0) {
+          if (millis() - refreshJob.startedMs < FETCH_WORKER_GIVEUP_MS) {
+              if (millis() - refreshJob.retryMs >= FETCH_WORKER_RETRY_MS) refreshJob.workers = startFetchWorkers();
+              if (refreshJob.workers == 0) return refreshState;
+          } else {
+              Serial.println("[NewsCore] No fetch task could start. Batch failed.");   // Every slot fails below
+          }
+      }
+      while (xSemaphoreTake(refreshJob.done, 0) == pdTRUE) refreshJob.finished++;
+      if (refreshJob.finished == refreshJob.workers) {
+          stopFetchWorkers();
+          for (int i = 0; i < refreshJob.count; i++) {
+              if (fetchSlots[i].phase != FETCH_DONE) { fetchSlots[i].ok = false; fetchSlots[i].phase = FETCH_DONE; }
+          }
+          refreshState = REFRESH_READY;
+      }
+  }
+#endif
+  return refreshState;
+}
+
+bool newsRefreshActive() {
+  return refreshState != REFRESH_IDLE;
+}
+
+// Each source counts equally: a tenth of its share for connecting, the
+// rest filling in as its stories are accepted
+int newsRefreshProgress() {
+  if (refreshState == REFRESH_IDLE) return 0;
+  if (refreshState == REFRESH_READY) return 100;
+  int total = 0;
+  for (int i = 0; i < refreshJob.count; i++) {
+      const FetchSlot& slot = fetchSlots[i];
+      if (slot.phase == FETCH_DONE) total += 100;
+      else if (slot.phase == FETCH_PARSING) total += 20 + 80 * min((int)slot.found, FETCH_LIMIT_PER_SRC) / FETCH_LIMIT_PER_SRC;
+      else if (slot.phase == FETCH_CONNECTING) total += 10;
+  }
+  return total / max(refreshJob.count, 1);
+}
+
+void commitNewsRefresh() {
+  if (refreshState != REFRESH_READY) return;
+  int count = refreshJob.count;
+
+  if (megaPool.capacity() < 100) megaPool.reserve(100);
+
+  // Stories the pool didn't have yet drive each source's schedule
+  for (int i = 0; i < count; i++) {
+      int src = refreshJob.sources[i];
+      int unseen = 0;
+      for (const auto& n : fetchSlots[i].stories) {
+          bool known = false;
+          for (const auto& s : megaPool) {
+              if (s.sourceIndex == src && s.headline == n.headline) { known = true; break; }
+          }
+          if (!known) unseen++;
+      }
+      scheduleSource(src, unseen, fetchSlots[i]);
   }
 
-  // 3-PHASE CLEANUP
-  megaPool.erase(std::remove_if(megaPool.begin(), megaPool.end(), [start, end](const Story& s) {
-        return (s.sourceIndex >= start && s.sourceIndex < end);
+  // 3-PHASE CLEANUP (only a complete read swaps a source's stories;
+  // unchanged, cut-short and failed ones, half-open probes included, keep theirs)
+  bool replace[30] = {false};
+  for (int i = 0; i < count; i++) replace[refreshJob.sources[i]] = fetchSlots[i].replaces;
+  megaPool.erase(std::remove_if(megaPool.begin(), megaPool.end(), [&replace](const Story& s) {
+        return replace[s.sourceIndex];
     }), megaPool.end());
 
-  // Fetch new data
-  for(int i = start; i < end; i++) {
-     fetchAndPool(i);
-     esp_task_wdt_reset();
+  // Merge in source order, whichever finished first
+  for(int i = 0; i < count; i++) {
+     if (!fetchSlots[i].ok) lastSyncFailed = true;
+     if (!replace[refreshJob.sources[i]]) fetchSlots[i].stories.clear();
+     for(auto& s : fetchSlots[i].stories) {
+        if (megaPool.size() >= MAX_POOL_SIZE) break;
+        megaPool.push_back(std::move(s));
+     }
+     fetchSlots[i].stories.clear();
   }
+  int workers = max(refreshJob.workers, 1);
+  Serial.print("[NewsCore] Batch fetched in "); Serial.print(millis() - refreshJob.startedMs);
+  Serial.print(" ms with "); Serial.print(workers); Serial.println(workers == 1 ? " worker" : " workers");
+  refreshState = REFRESH_IDLE;
   
   // Sort by date (Newest first)
   time_t newest = 0;
@@ -1080,13 +1672,16 @@ void refreshNewsData(int batchIndex) {
       Story s;
       s.headline = "SYSTEM: NO NEWS DATA AVAILABLE. WAITING FOR SYNC...";
       s.sourceIndex = 0; s.timeStr = "--:--"; s.url = ""; s.timestamp = 0;
+      layoutHeadline(s);
       megaPool.push_back(s);
       s.headline = "CHECKING NETWORK CONNECTION...";
+      layoutHeadline(s);
       s.sourceIndex = 1; megaPool.push_back(s);
       lastSyncFailed = true; 
   }
 
   // IMPORTANT: Re-build the playback deck because indices have changed
+  megaPoolGeneration++;
   resetPlaybackQueue();
   
   esp_task_wdt_reset();
@@ -1128,28 +1723,81 @@ void refreshNewsData(int batchIndex) {
   Serial.println("\n==========================================");
   Serial.println("[SUMMARY] BATCH SOURCE STATISTICS");
   Serial.println("==========================================");
-  int totalFetched = 0, totalAccepted = 0, totalDups = 0, totalErrors = 0;
-  for (int src = start; src < end; src++) {
+  int totalFetched = 0, totalAccepted = 0, totalDups = 0, totalErrors = 0, totalUnchanged = 0;
+  int totalHandshakes = 0, totalReused = 0;
+  uint32_t totalDrained = 0, totalReceived = 0, totalDecoded = 0;
+  int totalCompressed = 0;
+  for (int i = 0; i < count; i++) {
+      int src = refreshJob.sources[i];
       Serial.print("[SUMMARY] Source "); Serial.print(src); Serial.print(" - "); Serial.println(sources[src].name);
       Serial.print("  Fetched: "); Serial.print(sourceStats[src].fetched);
       Serial.print(" | Accepted: "); Serial.print(sourceStats[src].accepted);
       Serial.print(" | Duplicates: "); Serial.print(sourceStats[src].duplicates);
       Serial.print(" | Parse Errors: "); Serial.print(sourceStats[src].parseErrors);
-      Serial.print(" | Consecutive Fails: "); Serial.println(sourceStats[src].consecutiveFails);
+      Serial.print(" | Consecutive Fails: "); Serial.print(sourceStats[src].consecutiveFails);
+      Serial.print(" | Time: "); Serial.print(sourceStats[src].lastDurationMs); Serial.println(" ms");
       if (sourceStats[src].fetched > 0) {
         float acceptRate = (float)sourceStats[src].accepted / sourceStats[src].fetched * 100.0;
         Serial.print("  Accept Rate: "); Serial.print(acceptRate, 1); Serial.println("%");
       }
+      if (sourceStats[src].checks > 0) {
+        float skipRate = (float)sourceStats[src].unchanged / sourceStats[src].checks * 100.0;
+        Serial.print("  Unchanged: "); Serial.print(sourceStats[src].unchanged);
+        Serial.print("/"); Serial.print(sourceStats[src].checks);
+        Serial.print(" | Skip Rate: "); Serial.print(skipRate, 1); Serial.println("%");
+      }
+      Serial.print("  New: "); Serial.print(sourceStats[src].lastNew);
+      Serial.print(" | Rate: "); Serial.print(sourceStats[src].newPerHour, 2);
+      Serial.print("/h | Next In: "); Serial.print((long)(sourceStats[src].nextDueMs - millis()) / 60000); Serial.println(" min");
+      Serial.print("  Breaker: "); Serial.print(breakerName(sourceStats[src].breaker));
+      if (sourceStats[src].breaker == BREAKER_OPEN) {
+        Serial.print(" ("); Serial.print(outcomeName(sourceStats[src].openedBy)); Serial.print(", probe #");
+        Serial.print(sourceStats[src].reopens + 1); Serial.print(" in ");
+        Serial.print((long)(sourceStats[src].openUntilMs - millis()) / 60000); Serial.print(" min)");
+      }
+      Serial.print(" | Timeouts: "); Serial.print(sourceStats[src].timeouts);
+      Serial.print(" | HTTP Errors: "); Serial.print(sourceStats[src].httpErrors);
+      Serial.print(" | Unusable: "); Serial.println(sourceStats[src].parseFails);
       totalFetched += sourceStats[src].fetched;
       totalAccepted += sourceStats[src].accepted;
       totalDups += sourceStats[src].duplicates;
       totalErrors += sourceStats[src].parseErrors;
+      if (fetchSlots[i].unchanged) totalUnchanged++;
+      totalHandshakes += fetchSlots[i].handshakes;
+      if (fetchSlots[i].reused) totalReused++;
+      totalDrained += fetchSlots[i].drained;
+      totalReceived += fetchSlots[i].received;
+      totalDecoded += fetchSlots[i].decoded;
+      if (fetchSlots[i].compressed) totalCompressed++;
   }
   Serial.println("------------------------------------------");
   Serial.print("[SUMMARY] Batch Totals - Fetched: "); Serial.print(totalFetched);
   Serial.print(" | Accepted: "); Serial.print(totalAccepted);
   Serial.print(" | Duplicates: "); Serial.print(totalDups);
-  Serial.print(" | Errors: "); Serial.println(totalErrors);
+  Serial.print(" | Errors: "); Serial.print(totalErrors);
+  Serial.print(" | Unchanged: "); Serial.print(totalUnchanged); Serial.print("/"); Serial.println(count);
+  Serial.print("[SUMMARY] Connections - Handshakes: "); Serial.print(totalHandshakes);
+  Serial.print(" | Reused: "); Serial.print(totalReused);
+  Serial.print(" (~"); Serial.print((uint32_t)totalReused * TLS_HANDSHAKE_BYTES);
+  Serial.print(" handshake bytes saved) | Drained: "); Serial.print(totalDrained); Serial.println(" bytes");
+  Serial.print("[SUMMARY] Transfer - Received: "); Serial.print(totalReceived);
+  Serial.print(" bytes for "); Serial.print(totalDecoded);
+  Serial.print(" bytes of feed | Compressed: "); Serial.print(totalCompressed); Serial.print("/"); Serial.println(count);
+  int openCount = 0, halfOpenCount = 0;
+  for (int src = 0; src < 30; src++) {
+      if (sourceStats[src].breaker == BREAKER_OPEN) openCount++;
+      else if (sourceStats[src].breaker == BREAKER_HALF_OPEN) halfOpenCount++;
+  }
+  Serial.print("[SUMMARY] Breakers - Open: "); Serial.print(openCount);
+  Serial.print(" | Half-Open: "); Serial.print(halfOpenCount);
+  Serial.print(" | Closed: "); Serial.println(30 - openCount - halfOpenCount);
+  for (int src = 0; src < 30; src++) {
+      if (sourceStats[src].breaker != BREAKER_OPEN) continue;
+      Serial.print("[SUMMARY]   "); Serial.print(sources[src].name);
+      Serial.print(" - "); Serial.print(outcomeName(sourceStats[src].openedBy));
+      Serial.print(", opened "); Serial.print(sourceStats[src].opens);
+      Serial.print("x, probe in "); Serial.print((long)(sourceStats[src].openUntilMs - millis()) / 60000); Serial.println(" min");
+  }
   if (totalFetched > 0) {
     float overallRate = (float)totalAccepted / totalFetched * 100.0;
     Serial.print("[SUMMARY] Overall Accept Rate: "); Serial.print(overallRate, 1); Serial.println("%");
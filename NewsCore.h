@@ -22,6 +22,12 @@ struct Story {
   String url;           
   time_t timestamp;     
   int sourceIndex;
+  // Row layout (layoutHeadline): line i is lineLen[i] chars from lineStart[i],
+  // and "..." follows the last line when the headline didn't fit
+  uint8_t lineStart[HEADLINE_MAX_LINES];
+  uint8_t lineLen[HEADLINE_MAX_LINES];
+  uint8_t lineCount = 0;
+  bool ellipsis = false;
 };
 
 // --- EXTERNAL VARIABLES ---
@@ -29,13 +35,29 @@ extern std::vector<Story> megaPool;
 extern NewsSource sources[30]; 
 extern int failureCount;
 extern bool lastSyncFailed; 
+extern uint32_t megaPoolGeneration;   // Bumped whenever megaPool indices change
 
 // --- CORE FUNCTIONS ---
-void refreshNewsData(int batchIndex);
+// Word-wraps the headline into the row's text box (call when it changes)
+void layoutHeadline(Story& s);
+
+// Background refresh: plan which sources are due, start fetching them, step
+// it from loop() until READY, then commit once nothing on screen holds
+// megaPool indices mid-transition
+enum RefreshState { REFRESH_IDLE, REFRESH_FETCHING, REFRESH_READY };
+int planNewsRefresh(bool force);         // Picks up to 6 overdue sources (force: the 6 nearest due); returns how many
+bool startNewsRefresh();                 // Fetches the plan; false if nothing was started
+RefreshState stepNewsRefresh();
+void commitNewsRefresh();                // Merges the batch into megaPool
+bool newsRefreshActive();
+int newsRefreshProgress();               // 0-100 for the batch in flight
 
 // Returns the index of the next unique story, avoiding sources in the forbidden list
 int getNextStoryIndex(const std::vector<int>& forbiddenSources); 
 
+// Fills out[] with up to maxCount story indices likely to be dealt next
+int peekUpcomingStories(int* out, int maxCount);
+
 // Call this if the pool changes drastically to force a reshuffle
 void resetPlaybackQueue();
 
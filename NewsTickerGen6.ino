@@ -1,6 +1,6 @@
 /*
  * RANDY'S NEWS TICKER v50 (FINAL PRODUCTION BUILD)
- * - 30 Sources (5-Batch Cycle)
+ * - 30 Sources (Adaptive Per-Source Schedule)
  * - Smart 24h Cleanse (Replaces a download slot)
  * - Generous 10s Timeout
  */
@@ -15,34 +15,53 @@
 #include "TickerUI.h"
 
 RandyNet myWifi("Randy-News-Config");
-bool waveActive = false;
-int waveStep = 0;
-unsigned long lastWaveStepTime = 0;
-unsigned long waveStartTime = 0; 
+bool waveActive = false;   // Row transitions still running (TickerUI engine)
 
 int activeRowIndices[3] = {0, 0, 0};
 
+// Scroll mode: the next page is painted into the columns leaving on the
+// left, then the panel's scroll start moves so they reappear on the right.
+bool tapeActive = false;
+int tapeOffset = 0;
+int tapeRowIndices[3] = {0, 0, 0};
+unsigned long lastTapeFrame = 0;
+
 bool qrMode = false;
 int qrSelection = 0;
-int batchState = 0;
-bool isFastBoot = true;
-
-unsigned long getBatchIntervalMs(int batchIndex) {
-    // Production: batches 0/1 run 5 minutes apart; others use normal 15-minute interval
-    if (batchIndex == 0 || batchIndex == 1) return 300000UL;
-    return UPDATE_INTERVAL_MS;
-}
 
 // Easter Egg State
 int touchCounter = 0;
 unsigned long lastTapTime = 0;
 
-void updateNews() {
-  refreshNewsData(batchState);
-  
-    // Cycle 0 -> 1 -> 2 -> 3 -> 4 -> 0
-  batchState++;
-    if (batchState > 4) batchState = 0;
+// Parks the scroll at 0 and settles on the incoming page, so anything
+// painted next lands where it expects
+void stopTape() {
+  if (!tapeActive) return;
+  tapeActive = false;
+  tapeOffset = 0;
+  setScrollOffset(0);
+  for (int r = 0; r < 3; r++) activeRowIndices[r] = tapeRowIndices[r];
+  invalidateHeader();
+  displayBeginFrame();
+  drawHeader();
+  for (int r = 0; r < 3; r++) drawRowDirect(r, activeRowIndices[r]);
+  displayEndFrame();
+}
+
+// Starts fetching whichever sources are due (force: the next few, due or
+// not) in the background; loop() steps it and calls finishNews() once it's
+// in and the screen is between transitions
+void updateNews(bool force) {
+  if (newsRefreshActive()) return;
+  if (planNewsRefresh(force) == 0) return;
+  if (!tapeActive) drawSyncStatus(0, true, (long)UPDATE_INTERVAL_MS, 0);
+  startNewsRefresh();
+}
+
+void finishNews() {
+  cancelTransitions();
+  waveActive = false;
+  commitNewsRefresh();
   
   // Force reset queue to ensure we see new data
   resetPlaybackQueue();
@@ -61,31 +80,34 @@ void updateNews() {
   // 3. Get third story (avoiding source of #1 and #2)
   activeRowIndices[2] = getNextStoryIndex(usedSources);
   
+  displayBeginFrame();
   drawHeader();
   drawRowDirect(0, activeRowIndices[0]);
   drawRowDirect(1, activeRowIndices[1]);
   drawRowDirect(2, activeRowIndices[2]);
+  displayEndFrame();
 }
 
 void enterQRMode() {
+    stopTape();
     qrMode = true;
     qrSelection = 0; 
     drawQRForSelection();
 }
 
 void drawQRForSelection() {
-    int storyIdx = activeRowIndices[qrSelection];
-    if (storyIdx >= megaPool.size()) return;
-    Story s = megaPool[storyIdx];
-    drawQRCode(s.url.c_str(), s.headline.c_str());
+    drawStoryQR(activeRowIndices[qrSelection]);
 }
 
 void exitQRMode() {
     qrMode = false;
+    invalidateHeader();
+    displayBeginFrame();
     drawHeader();
     drawRowDirect(0, activeRowIndices[0]);
     drawRowDirect(1, activeRowIndices[1]);
     drawRowDirect(2, activeRowIndices[2]);
+    displayEndFrame();
 }
 
 void setup() {
@@ -101,6 +123,7 @@ void setup() {
   delay(500); 
   
   initDisplay();
+  if (DEBUG_MODE) benchmarkFill();
 
   fillRect(0, 0, 480, 320, BLACK);
   drawText(10, 150, 460, "BOOTING SYSTEM...", WHITE, BLACK, 2);
@@ -131,11 +154,13 @@ void loop() {
   static unsigned long lastFetch = 0;
   static unsigned long lastCarousel = millis();
   static unsigned long lastSecond = 0;
+  static unsigned long lastSpiReport = 0;
+  static uint32_t lastSpiBytes = 0;
   
   ArduinoOTA.handle();
   esp_task_wdt_reset();
   
-    unsigned long currentInterval = getBatchIntervalMs(batchState);
+    unsigned long currentInterval = UPDATE_INTERVAL_MS;
     long remaining = (long)currentInterval - (millis() - lastFetch);
   if (lastFetch == 0 || remaining < 0) remaining = 0;
 
@@ -149,28 +174,57 @@ void loop() {
       ESP.restart();
   }
 
-  if (!qrMode) {
-    drawSyncStatus(remaining, false, (long)currentInterval);
+  // Header widgets draw at fixed columns, so they sit out while the tape moves
+  if (!qrMode && !tapeActive) {
+    drawSyncStatus(remaining, newsRefreshActive(), (long)currentInterval, newsRefreshProgress());
       if (millis() - lastSecond >= 2000) {
           drawWiFiIcon();
           lastSecond = millis();
       }
   }
 
-  // --- ANIMATION SAFETY RESET ---
-  if (waveActive && millis() - waveStartTime > 3000) {
-      Serial.println("[UI] Animation stuck. Resetting.");
-      waveActive = false;
+  // --- DISPLAY BANDWIDTH REPORT ---
+  if (millis() - lastSpiReport >= 10000) {
+      uint32_t bytes = getSpiBytesSent();
+      if (DEBUG_MODE && lastSpiReport != 0) {
+          Serial.print("[UI] SPI bytes/s: ");
+          Serial.println((bytes - lastSpiBytes) * 1000UL / (millis() - lastSpiReport));
+      }
+      lastSpiBytes = bytes;
+      lastSpiReport = millis();
+  }
+
+#if DISPLAY_STATS
+  // --- SERIAL COMMANDS ("stats", "stats reset") ---
+  static char cmdLine[24];
+  static uint8_t cmdLen = 0;
+  while (Serial.available()) {
+      char c = Serial.read();
+      if (c == '\r') continue;
+      if (c != '\n') {
+          if (cmdLen < sizeof(cmdLine) - 1) cmdLine[cmdLen++] = c;
+          continue;
+      }
+      cmdLine[cmdLen] = 0;
+      cmdLen = 0;
+      if (strcmp(cmdLine, "stats") == 0) printDisplayStats();
+      else if (strcmp(cmdLine, "stats reset") == 0) { resetDisplayStats(); Serial.println("[DisplayHAL] Stats reset"); }
+  }
+#endif
+
+  // --- BACKGROUND SYNC ---
+  // Rows hold megaPool indices while they animate, so the batch only
+  // goes live between transitions
+  if (newsRefreshActive() && stepNewsRefresh() == REFRESH_READY && !qrMode && !waveActive && !tapeActive) {
+      finishNews();
+      lastCarousel = millis();
   }
 
   // --- CAROUSEL TRIGGER ---
-  if (!qrMode && !waveActive && millis() - lastCarousel > CAROUSEL_INTERVAL_MS) {
+  unsigned long carouselInterval = (DISPLAY_MODE == DISPLAY_MODE_SCROLL) ? SCROLL_DWELL_MS : CAROUSEL_INTERVAL_MS;
+  if (!qrMode && !waveActive && !tapeActive && millis() - lastCarousel > carouselInterval) {
      if(megaPool.size() > 0) {
-        waveActive = true;
-        waveStep = 0;
-        waveStartTime = millis(); 
         cycleHeaderTheme(); 
-        drawHeader();
 
         // Use 'usedSources' to track and prevent duplicate sources on screen
         std::vector<int> usedSources;
@@ -186,45 +240,59 @@ void loop() {
         // 3. Get third story (avoiding source of #1 and #2)
         int next2 = getNextStoryIndex(usedSources);
         
-        activeRowIndices[0] = next0; activeRowIndices[1] = next1; activeRowIndices[2] = next2;
+        if (DISPLAY_MODE == DISPLAY_MODE_SCROLL) {
+            tapeRowIndices[0] = next0; tapeRowIndices[1] = next1; tapeRowIndices[2] = next2;
+            tapeActive = true;
+            tapeOffset = 0;
+            lastTapeFrame = 0;
+        } else {
+            drawHeader();
+            activeRowIndices[0] = next0; activeRowIndices[1] = next1; activeRowIndices[2] = next2;
+            queueRowTransition(0, next0, ROW_EFFECT, 0);
+            queueRowTransition(1, next1, ROW_EFFECT, WAVE_DELAY_MS);
+            queueRowTransition(2, next2, ROW_EFFECT, WAVE_DELAY_MS);
+            waveActive = true;
+        }
         
         lastCarousel = millis();
-        lastWaveStepTime = millis();
      } else {
          lastCarousel = millis();
      }
   }
 
   // --- WAVE STEPPER ---
-  if (waveActive && !qrMode) {
-      if (waveStep == 0) {
-          drawRowDirect(0, activeRowIndices[0]);
-          waveStep++; lastWaveStepTime = millis();
-      }
-      else if (waveStep == 1 && millis() - lastWaveStepTime > WAVE_DELAY_MS) {
-          drawRowDirect(1, activeRowIndices[1]);
-          waveStep++; lastWaveStepTime = millis();
-      }
-      else if (waveStep == 2 && millis() - lastWaveStepTime > WAVE_DELAY_MS) {
-          drawRowDirect(2, activeRowIndices[2]);
-          waveActive = false; 
+  // One slice per frame; the bus drains in the background
+  if (waveActive && !qrMode) waveActive = stepTransitions();
+
+  // --- SCROLL STEPPER ---
+  if (tapeActive && !qrMode && millis() - lastTapeFrame >= SCROLL_FRAME_MS) {
+      int step = min(SCROLL_STEP_PX, 480 - tapeOffset);
+      drawHeaderStrip(tapeOffset, step);
+      for (int r = 0; r < 3; r++) drawRowStrip(r, tapeRowIndices[r], tapeOffset, step);
+      tapeOffset += step;
+      setScrollOffset(tapeOffset % 480);
+      lastTapeFrame = millis();
+
+      if (tapeOffset >= 480) {
+          // Page fully across: scroll start is back at 0, rest before the next one
+          tapeActive = false;
+          tapeOffset = 0;
+          for (int r = 0; r < 3; r++) activeRowIndices[r] = tapeRowIndices[r];
+          lastCarousel = millis();
       }
   }
 
+  // --- QR / HEADLINE PRE-RENDER (idle only) ---
+  if (!qrMode && !waveActive && !tapeActive) {
+      qrCacheStep(activeRowIndices, 3);
+      headlineCacheStep(activeRowIndices, 3);
+  }
+
   // --- FETCH TRIGGER ---
-  if (remaining == 0 && !qrMode) { 
+  if (remaining == 0 && !qrMode && !newsRefreshActive()) { 
     if (WiFi.status() == WL_CONNECTED) {
-        drawSyncStatus(0, true, (long)currentInterval);
-        updateNews();
-
-        unsigned long nextInterval = getBatchIntervalMs(batchState);
-        if (isFastBoot) {
-            // First boot: Wait only 3 mins for next batch (to fill pool faster)
-            lastFetch = millis() - (nextInterval - 180000);
-            isFastBoot = false;
-        } else {
-            lastFetch = millis();
-        }
+        updateNews(false);
+        lastFetch = millis();
     } 
     else {
         Serial.println("WiFi Down! Retrying in 60s...");
@@ -249,11 +317,19 @@ void loop() {
        }
     }
     
+    stopTape();
+    if (waveActive) {
+        // activeRowIndices already names the new stories; land them now so
+        // no row is left half-wiped, and so later slices can't hit a QR screen
+        finishTransitions();
+        waveActive = false;
+    }
     if (isLongPress) {
         if (!qrMode) {
-            drawSyncStatus(0, true, (long)currentInterval);
-            updateNews();
-            lastFetch = millis();
+            if (!newsRefreshActive()) {
+                updateNews(true);
+                lastFetch = millis();
+            }
         } else {
             exitQRMode();
         }
@@ -279,5 +355,5 @@ void loop() {
     }
     delay(200);
   }
-  delay(50);
+  delay((tapeActive || waveActive) ? 1 : 50);   // Animation frames are paced by their own timers
 }
\ No newline at end of file
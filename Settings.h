@@ -9,16 +9,73 @@
 
 // --- SYSTEM SETTINGS ---
 #define WDT_TIMEOUT_SECONDS 90  
-#define UPDATE_INTERVAL_MS  900000  // 15 Minutes (Cycles 1/3rd of sources each time)
+#define UPDATE_INTERVAL_MS  300000  // 5 Minutes: the scheduler wakes and fetches whichever sources are due
+#define REFRESH_BUDGET_PER_HOUR 30  // Feed requests per hour, all sources (the 5-batch rotation made ~33)
+#define SOURCE_MIN_INTERVAL_MS  900000    // Busiest sources: every 15 minutes at most
+#define SOURCE_MAX_INTERVAL_MS  14400000  // Quietest: at least every 4 hours
+#define SOURCE_TARGET_NEW   2.0f    // New stories a read should find on average
+#define SOURCE_RATE_SMOOTHING 0.3f  // EWMA weight of the latest new-story rate
 #define CAROUSEL_INTERVAL_MS 15000  // 15 Seconds per slide
 #define WAVE_DELAY_MS       500          
 #define PARSE_TIMEOUT_MS    15000   // [UPDATED] 15 Seconds (Increased for slow sources)
 #define SOURCE_FETCH_TIMEOUT_MS 20000  // Max time per source fetch
 #define ITEM_PARSE_TIMEOUT_MS   8000   // Max time per item parse
+#define BREAKER_TIMEOUT_TRIPS   2        // Consecutive timeouts that open a source's breaker
+#define BREAKER_HTTP_TRIPS      2        // ...HTTP errors (a 4xx other than 408/429 opens it at once)
+#define BREAKER_PARSE_TRIPS     3        // ...reads without a usable story
+#define BREAKER_TIMEOUT_MS      900000   // First open period after timeouts (15 min), doubling per failed probe
+#define BREAKER_HTTP_MS         1800000  // ...after HTTP errors (30 min)
+#define BREAKER_PARSE_MS        3600000  // ...after unusable feeds (1 h)
+#define BREAKER_MAX_MS          43200000 // Longest open period: 12 hours
+#define BREAKER_JITTER_PCT      25       // +/- spread on each open period
+#define BREAKER_PROBE_TIMEOUT_MS 8000    // Half-open probes give up sooner than SOURCE_FETCH_TIMEOUT_MS
+#ifndef FETCH_CONCURRENCY
+#define FETCH_CONCURRENCY   2       // Background fetch tasks per batch (0 = blocking, on the loop task)
+#endif
+#define FETCH_WORKER_HEAP   45000   // Free heap needed per concurrent TLS fetch
+#define FETCH_WORKER_STACK  12288
+#define FETCH_WORKER_RETRY_MS 1000  // No fetch task could start: try again this often...
+#define FETCH_WORKER_GIVEUP_MS 30000 // ...then fail the batch (the loop task never fetches)
+#define FEED_READ_BUFFER    1024    // Feed bytes pulled off the client per read
+#define FEED_GZIP_MIN_HEAP  90000   // Largest free block to ask for gzip: the ~44 KB inflater plus room for TLS
+#define FEED_TITLE_CHARS    256     // Per-item field capacities for the feed tokenizer
+#define FEED_LINK_CHARS     512
+#define FEED_DESC_CHARS     512
+#define FEED_CONTENT_CHARS  200     // Only the start of content:encoded is ever used
+#define KEEPALIVE_DRAIN_BYTES 65536 // Feed tail worth reading to keep a connection open
+#define TLS_HANDSHAKE_BYTES  5000   // Rough wire cost of a full TLS handshake (stats only)
+
+// --- DISPLAY MODE ---
+#define DISPLAY_MODE_WAVE   0       // Rows repaint top to bottom each carousel tick
+#define DISPLAY_MODE_SCROLL 1       // Pages crawl across on the panel's hardware scroll
+#define DISPLAY_MODE        DISPLAY_MODE_WAVE
+#define SCROLL_STEP_PX      4       // Columns exposed per frame (multiple of 4)
+#define SCROLL_FRAME_MS     40      // 4px / 40ms = 100 px/s, ~5s per page
+#define SCROLL_DWELL_MS     8000    // Rest between pages (header widgets run here)
+#define ROW_EFFECT_CUT      0       // Wave mode row transitions
+#define ROW_EFFECT_WIPE     1
+#define ROW_EFFECT_SLIDE    2
+#define ROW_EFFECT          ROW_EFFECT_WIPE
+#define TRANSITION_FRAME_MS 16
+#define WIPE_LINES_PER_FRAME 10     // 10 frames per row
+#define SLIDE_PX_PER_FRAME  48      // Multiple of 4
+#ifndef DISPLAY_PIPELINE
+#define DISPLAY_PIPELINE    1       // Render on a dedicated display task (0 = draw inline)
+#endif
+#ifndef DISPLAY_LIST
+#define DISPLAY_LIST        1       // Record multi-primitive redraws and drop overdraw
+#endif
+#define DISPLAY_LIST_MAX    48      // Commands held per frame (~100 bytes each)
+#ifndef DISPLAY_STATS
+#define DISPLAY_STATS       0       // Display I/O counters + "stats" serial command (0 = compiled out)
+#endif
 
 // Limits based on user request
 #define MAX_POOL_SIZE       180     // Accommodates 30 sources
-#define MAX_HEADLINE_LEN    114     // Hard crop for display width
+#define MAX_HEADLINE_LEN    240     // Safety crop; layout decides what shows (8-bit offsets)
+#define HEADLINE_MAX_LINES  3       // Size-2 lines that fit under the source bar
+#define HEADLINE_LINE_CHARS 38      // 460px headline box / 12px cells
+#define HEADLINE_CACHE_BYTES 20000  // 1bpp headline bitmaps, ~3.2 KB each
 #define FETCH_LIMIT_PER_SRC 6       // 30 * 6 = 180 max stories
 #define MAX_AGE_SECONDS     129600  // 36 Hours
 
@@ -10,89 +10,404 @@ int currentThemeIdx = 0;
 void cycleHeaderTheme() { currentThemeIdx = (currentThemeIdx + 1) % 5; }
 int getCurrentThemeIndex() { return currentThemeIdx; }
 
-void drawHeader() {
-  fillRect(0, 0, 480, 20, BLACK);
-  // Separator is now covered by the sync bar area usually, but we keep it
-  fillRect(0, 19, 480, 1, CHARCOAL);
-  
-  if (lastSyncFailed) {
-      // [FIX] Moved UP to 0 to prevent touching the bar
-      drawText(10, 0, 200, "SYNC ERROR", RED, BLACK, 2, false);
-  } else {
-      // [FIX] Moved UP to 0
-      drawText(10, 0, 200, "NEWS TICKER", WHITE, BLACK, 2, false);
-  }
-  
-  int rssi = WiFi.RSSI();
-  if (WiFi.status() != WL_CONNECTED) rssi = -999;
-  
+// --- RETAINED HEADER STATE (Damage Tracking) ---
+// Remembers what the header widgets last put on the glass so each call
+// only sends the pixels that changed.
+enum { TITLE_NONE = -1, TITLE_NEWS, TITLE_ERROR, TITLE_UPDATING };
+struct HeaderState {
+  bool valid = false;      // Cleared when a full-screen view paints over the header
+  int title = TITLE_NONE;
+  int barWidth = 0;        // Blue pixels currently in the sync bar
+};
+static HeaderState hdr;
+
+void invalidateHeader() { hdr.valid = false; }
+
+static void paintTitle(int title) {
+  if (title == hdr.title) return;
+  // Clear Title Area (Height 18 to leave bar alone)
+  fillRect(0, 0, 400, 18, BLACK);
+  // [FIX] Title sits at Y=0 to prevent touching the bar
+  if (title == TITLE_UPDATING) drawText(10, 0, 380, "UPDATING...", CYAN, BLACK, 2, false);
+  else if (title == TITLE_ERROR) drawText(10, 0, 380, "SYNC ERROR", RED, BLACK, 2, false);
+  else drawText(10, 0, 200, "NEWS TICKER", WHITE, BLACK, 2, false);
+  hdr.title = title;
+}
+
+static void paintSyncBar(int barWidth) {
+  // Bar is at Y=18 (height 2). Only the span between old and new width changes.
+  if (barWidth > hdr.barWidth) fillRect(hdr.barWidth, 18, barWidth - hdr.barWidth, 2, BLUE);
+  else if (barWidth < hdr.barWidth) fillRect(barWidth, 18, hdr.barWidth - barWidth, 2, CHARCOAL);
+  hdr.barWidth = barWidth;
+}
+
+static int currentRssi() {
+  if (WiFi.status() != WL_CONNECTED) return -999;
+  return WiFi.RSSI();
+}
+
+static void paintFullHeader() {
+  fillRect(0, 0, 480, 18, BLACK);
+  // Empty sync bar doubles as the separator
+  fillRect(0, 18, 480, 2, CHARCOAL);
+  hdr.barWidth = 0;
+  hdr.title = TITLE_NONE;
   // [FIX] WiFi meter moved to Y=0
-  drawSignalBars(400, 0, rssi, true); 
+  drawSignalBars(400, 0, currentRssi(), true);
+  hdr.valid = true;
+}
+
+void drawHeader() {
+  DISPLAY_STAT_SCOPE(STAT_HEADER_FRAME);
+  displayBeginFrame();
+  if (!hdr.valid) paintFullHeader();
+  paintTitle(lastSyncFailed ? TITLE_ERROR : TITLE_NEWS);
+  displayEndFrame();
+#if DISPLAY_STATS
+  displayFlush();   // Time the frame onto the glass, not just its submit
+#endif
 }
 
 void drawWiFiIcon() {
-  int rssi = WiFi.RSSI();
-  if (WiFi.status() != WL_CONNECTED) rssi = -999;
-  drawSignalBars(400, 0, rssi, false); 
+  if (!hdr.valid) { drawHeader(); return; }
+  drawSignalBars(400, 0, currentRssi(), false); 
 }
 
-void drawSyncStatus(long remainingMs, bool isSyncing, long intervalMs) {
+void drawSyncStatus(long remainingMs, bool isSyncing, long intervalMs, int syncPercent) {
+    if (!hdr.valid) paintFullHeader();
+
     int barWidth = 480;
-    if (!isSyncing && remainingMs > 0) {
-        long safeInterval = intervalMs > 0 ? intervalMs : UPDATE_INTERVAL_MS;
-        barWidth = map(remainingMs, 0, safeInterval, 0, 480);
-    }
-    
-    // Bar is at Y=18 (height 2). Text at Y=0 (height 16). Gap is Y=16,17. Perfect.
     if (isSyncing) {
-        fillRect(0, 18, 480, 2, BLUE); 
-    } else {
-        fillRect(0, 18, barWidth, 2, BLUE); 
-        if (barWidth < 480) fillRect(barWidth, 18, 480 - barWidth, 2, CHARCOAL);
+        // Fills up as the batch comes in
+        barWidth = constrain(syncPercent, 0, 100) * 480 / 100;
+    } else if (remainingMs > 0) {
+        long safeInterval = intervalMs > 0 ? intervalMs : UPDATE_INTERVAL_MS;
+        barWidth = constrain(map(remainingMs, 0, safeInterval, 0, 480), 0, 480);
     }
+    paintSyncBar(barWidth);
 
-    static bool lastStateWasSync = false;
-    static bool firstRun = true;
-    static bool lastStateWasError = false;
-    
-    bool statusChanged = (isSyncing != lastStateWasSync) || (lastSyncFailed != lastStateWasError);
+    if (isSyncing) paintTitle(TITLE_UPDATING);
+    else paintTitle(lastSyncFailed ? TITLE_ERROR : TITLE_NEWS);
+}
 
-    if (statusChanged || firstRun) {
-        // Clear Title Area (Height 18 to leave bar alone)
-        fillRect(0, 0, 400, 18, BLACK); 
+// Row compositor: one 480x100 story row at 2bpp (12 KB), pushed in one pass
+enum { ROW_BG = 0, ROW_TEXT = 1, ROW_TITLE = 2 };
+static uint8_t rowPixels[480 * 100 / 4];
+static bool rowPixelsQueued = false;   // Transition slices still reading rowPixels
 
-        if (isSyncing) {
-             drawText(10, 0, 380, "UPDATING...", CYAN, BLACK, 2, false);
-        } 
-        else if (lastSyncFailed) {
-             drawText(10, 0, 380, "SYNC ERROR", RED, BLACK, 2, false);
-        }
-        else {
-             drawText(10, 0, 200, "NEWS TICKER", WHITE, BLACK, 2, false);
-        }
-        
-        lastStateWasSync = isSyncing;
-        lastStateWasError = lastSyncFailed;
-        firstRun = false;
+// Waits out any queued slices before rowPixels is recomposed
+static void claimRowPixels() {
+  if (!rowPixelsQueued) return;
+  displayFlush();
+  rowPixelsQueued = false;
+}
+
+// Visible rows first, then the next cards on the deck
+static int wantedStories(const int* visibleRows, int count, int* out, int maxCount) {
+  int n = 0;
+  for (int i = 0; i < count && n < maxCount; i++) {
+    if (visibleRows[i] < megaPool.size()) out[n++] = visibleRows[i];
+  }
+  return n + peekUpcomingStories(out + n, maxCount - n);
+}
+
+// --- HEADLINE BITMAP CACHE ---
+// The headline box pre-rendered at 1bpp, so composing a row is a blit in
+// the source's colors. Filled between carousel ticks; any pool change
+// (megaPoolGeneration) drops every entry since story indices move.
+#define HEADLINE_BMP_X       8      // 4-aligned so the blit packs whole canvas bytes
+#define HEADLINE_BMP_Y       35
+#define HEADLINE_BMP_W       464
+#define HEADLINE_BMP_H       (HEADLINE_MAX_LINES * 20 - 4)
+#define HEADLINE_BMP_BYTES   (HEADLINE_BMP_W / 8 * HEADLINE_BMP_H)
+#define HEADLINE_CACHE_SLOTS (HEADLINE_CACHE_BYTES / HEADLINE_BMP_BYTES)
+struct HeadlineBitmap {
+  int story = -1;            // megaPool index, -1 = empty
+  unsigned long lastUsed = 0;
+};
+static HeadlineBitmap hlCache[HEADLINE_CACHE_SLOTS];
+static uint8_t hlBits[HEADLINE_CACHE_SLOTS][HEADLINE_BMP_BYTES];
+static uint32_t hlGeneration = 0;
+
+static MonoCanvas headlineCanvas(int slot) {
+  MonoCanvas mc = { HEADLINE_BMP_W, HEADLINE_BMP_H, HEADLINE_BMP_W / 8, hlBits[slot] };
+  return mc;
+}
+
+static int headlineSlot(int storyIndex) {
+  if (hlGeneration != megaPoolGeneration) {
+    for (int i = 0; i < HEADLINE_CACHE_SLOTS; i++) hlCache[i].story = -1;
+    hlGeneration = megaPoolGeneration;
+  }
+  for (int i = 0; i < HEADLINE_CACHE_SLOTS; i++) if (hlCache[i].story == storyIndex) return i;
+  return -1;
+}
+
+static void renderHeadline(int slot, int storyIndex) {
+  const Story& s = megaPool[storyIndex];
+  MonoCanvas mc = headlineCanvas(slot);
+  memset(mc.bits, 0, HEADLINE_BMP_BYTES);
+  const char* text = s.headline.c_str();
+  int x = 10 - HEADLINE_BMP_X;
+  for (int i = 0; i < s.lineCount; i++) {
+    monoDrawLine(mc, x, i * 20, text + s.lineStart[i], s.lineLen[i], 2);
+    if (s.ellipsis && i == s.lineCount - 1) monoDrawLine(mc, x + s.lineLen[i] * 12, i * 20, "...", 3, 2);
+  }
+  hlCache[slot].story = storyIndex;
+  hlCache[slot].lastUsed = millis();
+}
+
+void headlineCacheStep(const int* visibleRows, int count) {
+  int wanted[HEADLINE_CACHE_SLOTS];
+  int n = wantedStories(visibleRows, count, wanted, HEADLINE_CACHE_SLOTS);
+  for (int i = 0; i < n; i++) {
+    if (headlineSlot(wanted[i]) >= 0) continue;
+    // Evict the stalest slot nobody on the wanted list needs
+    int victim = -1;
+    for (int s = 0; s < HEADLINE_CACHE_SLOTS; s++) {
+      bool needed = false;
+      for (int k = 0; k < n; k++) if (hlCache[s].story == wanted[k]) needed = true;
+      if (needed) continue;
+      if (victim < 0 || hlCache[s].lastUsed < hlCache[victim].lastUsed) victim = s;
+    }
+    if (victim >= 0) renderHeadline(victim, wanted[i]);
+    return; // One render per idle step
+  }
+}
+
+// Lays out one story row; the canvas covers row columns originX..originX+width-1
+static void composeRow(PaletteCanvas& row, int originX, int storyIndex) {
+  const Story& s = megaPool[storyIndex];
+  const NewsSource& src = sources[s.sourceIndex];
+  canvasFillRect(row, 0, 0, row.width, 100, ROW_BG);
+  canvasDrawText(row, 10 - originX, 8, 460, src.name.c_str(), ROW_TITLE, ROW_BG, 2, true);
+  canvasFillRect(row, 0, 28, row.width, 2, ROW_TEXT);
+  if (s.timeStr != "") canvasDrawText(row, 300 - originX, 8, 170, s.timeStr.c_str(), ROW_TEXT, ROW_BG, 2, false);
+
+  int slot = headlineSlot(storyIndex);
+  if (slot >= 0) {
+    hlCache[slot].lastUsed = millis();
+    canvasBlitMono(row, HEADLINE_BMP_X - originX, HEADLINE_BMP_Y, headlineCanvas(slot), ROW_TEXT, ROW_BG);
+    return;
+  }
+  // Miss: headline lines were laid out at ingest; just walk them
+  const char* text = s.headline.c_str();
+  for (int i = 0; i < s.lineCount; i++) {
+    int y = HEADLINE_BMP_Y + i * 20;
+    canvasDrawLine(row, 10 - originX, y, text + s.lineStart[i], s.lineLen[i], ROW_TEXT, ROW_BG, 2);
+    if (s.ellipsis && i == s.lineCount - 1) {
+      canvasDrawLine(row, 10 - originX + s.lineLen[i] * 12, y, "...", 3, ROW_TEXT, ROW_BG, 2);
     }
+  }
 }
 
 void drawRowDirect(int rowIndex, int storyIndex) {
+  DISPLAY_STAT_SCOPE(STAT_ROW_FRAME);
+  drawRowStrip(rowIndex, storyIndex, 0, 480);
+}
+
+void drawRowStrip(int rowIndex, int storyIndex, int stripX, int stripW) {
   if (storyIndex >= megaPool.size()) return;
-  Story s = megaPool[storyIndex];
-  NewsSource src = sources[s.sourceIndex];
+  const Story& s = megaPool[storyIndex];
+  const NewsSource& src = sources[s.sourceIndex];
   int yPos = 20 + (rowIndex * 100);
-  
-  fillRect(0, yPos, 480, 100, src.bgColor);
-  drawText(10, yPos + 8, 460, src.name.c_str(), src.titleColor, src.bgColor, 2, true);
-  fillRect(0, yPos + 28, 480, 2, src.color);
-  if (s.timeStr != "") drawText(300, yPos + 8, 170, s.timeStr.c_str(), src.color, src.bgColor, 2, false);
-  drawText(10, yPos + 35, 460, s.headline.c_str(), src.color, src.bgColor, 2, false);
+
+  claimRowPixels();
+  PaletteCanvas row = { (uint16_t)stripW, 100, rowPixels, { src.bgColor, src.color, src.titleColor, BLACK } };
+  composeRow(row, stripX, storyIndex);
+  pushCanvas(row, stripX, yPos);
+}
+
+void drawHeaderStrip(int stripX, int stripW) {
+  // Static stand-in for the header while it scrolls; live widgets come back at rest
+  claimRowPixels();
+  PaletteCanvas band = { (uint16_t)stripW, 20, rowPixels, { BLACK, WHITE, CHARCOAL, BLACK } };
+  canvasFillRect(band, 0, 0, stripW, 18, 0);
+  canvasDrawText(band, 10 - stripX, 0, 200, "NEWS TICKER", 1, 0, 2, false);
+  canvasFillRect(band, 0, 18, stripW, 2, 2);
+  pushCanvas(band, stripX, 0);
+  invalidateHeader();
+}
+
+// --- ROW TRANSITIONS ---
+// Rows queue up and run one after another. Each frame queues one slice of
+// the composed row without waiting for the bus, so loop() keeps turning.
+struct RowTransition {
+  int row;
+  int story;
+  int effect;
+  unsigned long delayMs;   // Pause after the previous transition ends
+};
+static RowTransition fxQueue[3];
+static int fxCount = 0;
+static bool fxRunning = false;
+static int fxProgress = 0;             // Scanlines (wipe) or columns (slide) shown
+static unsigned long fxNextFrame = 0;
+static PaletteCanvas fxCanvas;
+
+void queueRowTransition(int rowIndex, int storyIndex, int effect, unsigned long delayMs) {
+  if (fxCount >= 3) return;
+  if (fxCount == 0 && !fxRunning) fxNextFrame = millis() + delayMs;
+  fxQueue[fxCount++] = { rowIndex, storyIndex, effect, delayMs };
+}
+
+bool transitionsActive() { return fxRunning || fxCount > 0; }
+
+void cancelTransitions() {
+  fxCount = 0;
+  fxRunning = false;
+  claimRowPixels();
+}
+
+void finishTransitions() {
+  RowTransition pending[3];
+  int n = fxCount;
+  for (int i = 0; i < n; i++) pending[i] = fxQueue[i];
+  cancelTransitions();
+  for (int i = 0; i < n; i++) drawRowDirect(pending[i].row, pending[i].story);
+}
+
+static void popTransition() {
+  for (int i = 1; i < fxCount; i++) fxQueue[i - 1] = fxQueue[i];
+  fxCount--;
+  fxRunning = false;
+  if (fxCount > 0) fxNextFrame = millis() + fxQueue[0].delayMs;
+}
+
+bool stepTransitions() {
+  if (!transitionsActive()) return false;
+  if ((long)(millis() - fxNextFrame) < 0) return true;
+  fxNextFrame = millis() + TRANSITION_FRAME_MS;
+
+  RowTransition& t = fxQueue[0];
+  if (t.story >= megaPool.size()) { popTransition(); return transitionsActive(); }
+  int yPos = 20 + (t.row * 100);
+
+  if (!fxRunning) {
+    const Story& s = megaPool[t.story];
+    const NewsSource& src = sources[s.sourceIndex];
+    claimRowPixels();
+    fxCanvas = { 480, 100, rowPixels, { src.bgColor, src.color, src.titleColor, BLACK } };
+    composeRow(fxCanvas, 0, t.story);
+    fxRunning = true;
+    fxProgress = 0;
+  }
+
+  rowPixelsQueued = true;
+  if (t.effect == ROW_EFFECT_WIPE) {
+    // Top-down: the next band of scanlines
+    int lines = min(WIPE_LINES_PER_FRAME, 100 - fxProgress);
+    pushCanvasRect(fxCanvas, 0, fxProgress, 480, lines, 0, yPos + fxProgress);
+    fxProgress += lines;
+    if (fxProgress >= 100) popTransition();
+  } else if (t.effect == ROW_EFFECT_SLIDE) {
+    // New row slides in from the right over the old one
+    fxProgress = min(fxProgress + SLIDE_PX_PER_FRAME, 480);
+    pushCanvasRect(fxCanvas, 0, 0, fxProgress, 100, 480 - fxProgress, yPos);
+    if (fxProgress >= 480) popTransition();
+  } else {
+    pushCanvasRect(fxCanvas, 0, 0, 480, 100, 0, yPos);
+    popTransition();
+  }
+  return transitionsActive();
+}
+
+// --- QR CACHE ---
+#define QR_CACHE_SLOTS 6     // 3 on screen + 3 upcoming
+struct QRCacheEntry {
+  uint32_t key = 0;          // 0 = empty
+  String url;                // Checked on every hit: keys are only 32 bits
+  bool encoded = false;      // false: URL can't be encoded (show the error screen)
+  unsigned long lastUsed = 0;
+  QRImage image;
+};
+static QRCacheEntry qrCache[QR_CACHE_SLOTS];
+static uint32_t qrHits = 0, qrMisses = 0, qrEncodes = 0;
+static uint32_t qrEncodeUs = 0;
+
+static uint32_t storyKey(const Story& s) {
+  // FNV-1a over the URL (the QR payload); never 0 so 0 can mean empty
+  uint32_t h = 2166136261UL;
+  for (unsigned int i = 0; i < s.url.length(); i++) { h ^= (uint8_t)s.url[i]; h *= 16777619UL; }
+  return h ? h : 1;
+}
+
+static QRCacheEntry* qrLookup(uint32_t key, const String& url) {
+  for (int i = 0; i < QR_CACHE_SLOTS; i++) {
+    if (qrCache[i].key == key && qrCache[i].url == url) return &qrCache[i];
+  }
+  return NULL;
+}
+
+static void qrEncodeInto(QRCacheEntry& e, uint32_t key, const Story& s) {
+  unsigned long t0 = micros();
+  e.key = key;
+  e.url = s.url;
+  e.encoded = encodeQRCode(s.url.c_str(), e.image);
+  e.lastUsed = millis();
+  qrEncodeUs += micros() - t0;
+  qrEncodes++;
+}
+
+void qrCacheStep(const int* visibleRows, int count) {
+  int wanted[QR_CACHE_SLOTS];
+  int n = wantedStories(visibleRows, count, wanted, QR_CACHE_SLOTS);
+
+  uint32_t keys[QR_CACHE_SLOTS];
+  for (int i = 0; i < n; i++) keys[i] = storyKey(megaPool[wanted[i]]);
+
+  for (int i = 0; i < n; i++) {
+    if (qrLookup(keys[i], megaPool[wanted[i]].url)) continue;
+    // Evict the stalest slot nobody on the wanted list needs
+    QRCacheEntry* victim = NULL;
+    for (int s = 0; s < QR_CACHE_SLOTS; s++) {
+      bool needed = false;
+      for (int k = 0; k < n; k++) if (qrCache[s].key == keys[k] && qrCache[s].url == megaPool[wanted[k]].url) needed = true;
+      if (needed) continue;
+      if (!victim || qrCache[s].lastUsed < victim->lastUsed) victim = &qrCache[s];
+    }
+    if (!victim) return;
+    qrEncodeInto(*victim, keys[i], megaPool[wanted[i]]);
+    return; // One encode per idle step
+  }
+}
+
+void drawStoryQR(int storyIndex) {
+  if (storyIndex >= megaPool.size()) return;
+  const Story& s = megaPool[storyIndex];
+  uint32_t key = storyKey(s);
+
+  QRCacheEntry* e = qrLookup(key, s.url);
+  bool hit = (e != NULL);
+  if (hit) qrHits++;
+  else {
+    qrMisses++;
+    e = &qrCache[0];
+    for (int i = 1; i < QR_CACHE_SLOTS; i++) if (qrCache[i].lastUsed < e->lastUsed) e = &qrCache[i];
+    qrEncodeInto(*e, key, s);
+  }
+  e->lastUsed = millis();
+
+  if (e->encoded) drawQRImage(e->image, s.headline.c_str());
+  else drawQRCode(s.url.c_str(), s.headline.c_str());  // Error screens
+
+  #ifdef DEBUG_MODE
+  if (DEBUG_MODE) {
+    Serial.print("[UI] QR cache "); Serial.print(hit ? "hit" : "miss");
+    Serial.print(" | hits: "); Serial.print(qrHits);
+    Serial.print(" misses: "); Serial.print(qrMisses);
+    Serial.print(" | avg encode: "); Serial.print(qrEncodes ? qrEncodeUs / qrEncodes : 0);
+    Serial.println(" us");
+  }
+  #endif
 }
 
 void triggerEasterEgg() {
+    invalidateHeader();
+    displayBeginFrame();
     fillRect(0, 0, 480, 320, BLACK);
     drawText(50, 150, 400, EASTER_EGG_TEXT, GREEN, BLACK, 2, true);
+    displayEndFrame();
     long start = millis();
     while(millis() - start < 5000) {
         esp_task_wdt_reset(); 
@@ -101,15 +416,20 @@ void triggerEasterEgg() {
 }
 
 void showConfigScreen() {
+  invalidateHeader();
+  displayBeginFrame();
   fillRect(0, 0, 480, 320, BLACK);
   drawText(10, 100, 460, "STATUS: WIFI FAILED.", RED, BLACK, 2, true);
   drawText(10, 160, 460, "CONNECT TO THIS WIFI:", WHITE, BLACK, 2, false);
   drawText(10, 190, 460, "Randys-News-Config", YELLOW, BLACK, 2, false);
   drawText(10, 240, 460, "THEN BROWSE TO IP:", WHITE, BLACK, 2, false);
   drawText(10, 270, 460, "http://1.1.1.1", YELLOW, BLACK, 2, false);
+  displayEndFrame();
 }
 
 void drawSplashScreen() {
+  invalidateHeader();
+  displayBeginFrame();
   fillRect(0, 0, 480, 320, BLACK);
   
   // Title (RED instead of CYAN)
@@ -128,6 +448,7 @@ void drawSplashScreen() {
   
   // Wait for long press to start
   drawText(10, 270, 460, "LONG PRESS TO START", GOLD, BLACK, 2, true);
+  displayEndFrame();
   
   // Wait for long press with 5-minute timeout
   unsigned long splashStart = millis();
@@ -148,8 +469,10 @@ void drawSplashScreen() {
       int seconds = secondsRemaining % 60;
       char timeoutStr[30];
       sprintf(timeoutStr, "Auto-start in %d:%02d", minutes, seconds);
+      displayBeginFrame();
       fillRect(10, 290, 460, 20, BLACK);  // Clear previous text
       drawText(10, 290, 460, timeoutStr, GREY, BLACK, 1, false);
+      displayEndFrame();
     }
     
     if (digitalRead(TOUCH_IRQ) == LOW) {
@@ -11,11 +11,35 @@ void cycleHeaderTheme();
 int getCurrentThemeIndex();
 
 // --- DRAWING FUNCTIONS ---
+// Header widgets keep retained state and only repaint what changed.
+// Call invalidateHeader() after anything paints over the header area.
+void invalidateHeader();
 void drawHeader();
 void drawWiFiIcon();
 void drawRowDirect(int rowIndex, int storyIndex);
+// Scroll mode: paint columns stripX..stripX+stripW-1 of a row / the header band
+// (stripW must be a multiple of 4)
+void drawRowStrip(int rowIndex, int storyIndex, int stripX, int stripW);
+void drawHeaderStrip(int stripX, int stripW);
 // [NEW] Sync Status Indicator
-void drawSyncStatus(long remainingMs, bool isSyncing, long intervalMs);
+void drawSyncStatus(long remainingMs, bool isSyncing, long intervalMs, int syncPercent = 100);
+// --- ROW TRANSITIONS ---
+// Frame-scheduled row repaints (ROW_EFFECT_* in Settings.h). Call
+// stepTransitions() every loop; it returns true while any are pending.
+void queueRowTransition(int rowIndex, int storyIndex, int effect, unsigned long delayMs);
+bool stepTransitions();
+bool transitionsActive();
+void cancelTransitions();   // Drops pending rows; repaint them directly
+void finishTransitions();   // Jumps running and queued rows to their new story
+// --- HEADLINE BITMAP CACHE ---
+// Pre-renders 1bpp headlines for the visible rows and the next cards
+// (HEADLINE_CACHE_BYTES budget). Each step renders at most one.
+void headlineCacheStep(const int* visibleRows, int count);
+// --- QR CACHE ---
+// Pre-encodes QR codes for the visible rows and the next few cards during
+// idle time, keyed by story URL. Each step encodes at most one code.
+void qrCacheStep(const int* visibleRows, int count);
+void drawStoryQR(int storyIndex);   // Blits from the cache, encodes on a miss
 // --- SPECIAL SCREENS ---
 void triggerEasterEgg();
 void showConfigScreen();
@@ -0,0 +1,32 @@
+#include <Arduino.h>
+#include <WiFi.h>
+#include "HostRuntime.h"
+
+HardwareSerial Serial;
+EspClass ESP;
+WiFiClass WiFi;
+
+// --- VIRTUAL CLOCK ---
+// Advances only on delay() (plus a tick per micros() read so busy-wait
+// loops still terminate), keeping every run deterministic.
+static unsigned long long nowUs = 0;
+static unsigned long touchUntilMs = 0;
+
+unsigned long millis() { return nowUs / 1000; }
+unsigned long micros() { return nowUs++; }
+void delay(unsigned long ms) { nowUs += (unsigned long long)ms * 1000; }
+void yield() {}
+
+void pinMode(int, int) {}
+void digitalWrite(int, int) {}
+
+int digitalRead(int pin) {
+  if (pin == TOUCH_IRQ) return millis() < touchUntilMs ? LOW : HIGH;
+  return HIGH;
+}
+
+long random(long maxVal) { return maxVal > 0 ? rand() % maxVal : 0; }
+long random(long minVal, long maxVal) { return maxVal > minVal ? minVal + rand() % (maxVal - minVal) : minVal; }
+void randomSeed(unsigned long seed) { srand(seed); }
+
+void hostHoldTouch(unsigned long ms) { touchUntilMs = millis() + ms; }
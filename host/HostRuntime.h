@@ -0,0 +1,9 @@
+#ifndef HOST_RUNTIME_H
+#define HOST_RUNTIME_H
+
+#include "Settings.h"
+
+// Holds the touch IRQ low for ms of virtual time (long press = 800+)
+void hostHoldTouch(unsigned long ms);
+
+#endif
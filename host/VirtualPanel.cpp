@@ -0,0 +1,146 @@
+#include "VirtualPanel.h"
+#include "LcdBus.h"
+
+static uint16_t memory[PANEL_H][PANEL_W];
+static PanelCounters counters;
+static uint32_t bytesTotal = 0;     // Since boot, for lcdBusBytesSent()
+static FILE* trace = NULL;
+
+// Decoder state
+static uint8_t cmd = 0;
+static uint8_t args[6];
+static uint8_t argCount = 0;
+static uint16_t colStart = 0, colEnd = PANEL_W - 1, rowStart = 0, rowEnd = PANEL_H - 1;
+static uint16_t curX = 0, curY = 0;
+static bool highByte = true;
+static uint8_t pixelHigh = 0;
+static uint16_t scrollTop = 0, scrollArea = PANEL_W, scrollStart = 0;
+
+static uint8_t pixelBuf[2][LCD_BUS_BUFFER_BYTES];
+static uint8_t curBuf = 0;
+
+static void countBytes(uint32_t n) {
+  counters.bytes += n;
+  bytesTotal += n;
+}
+
+static void decodeParam(uint8_t b) {
+  if (argCount < sizeof(args)) args[argCount++] = b;
+  uint16_t a = (args[0] << 8) | args[1];
+  uint16_t c = (args[2] << 8) | args[3];
+  switch (cmd) {
+    case CASET: if (argCount == 4) { colStart = a; colEnd = c; } break;
+    case RASET: if (argCount == 4) { rowStart = a; rowEnd = c; } break;
+    case VSCRDEF: if (argCount == 6) { scrollTop = a; scrollArea = c; } break;
+    case VSCRSADD: if (argCount == 2) scrollStart = a; break;
+  }
+}
+
+static void decodePixelByte(uint8_t b) {
+  if (highByte) { pixelHigh = b; highByte = false; return; }
+  highByte = true;
+  if (curY <= rowEnd && curX < PANEL_W && curY < PANEL_H) memory[curY][curX] = (pixelHigh << 8) | b;
+  if (++curX > colEnd) { curX = colStart; curY++; }
+}
+
+void lcdBusBegin() {
+  memset(memory, 0, sizeof(memory));
+  panelResetCounters();
+}
+
+void lcdBusCommand(uint8_t c) {
+  cmd = c;
+  argCount = 0;
+  memset(args, 0, sizeof(args));
+  if (c == RAMWR) { curX = colStart; curY = rowStart; highByte = true; }
+  counters.commandBytes++;
+  counters.transactions++;
+  countBytes(1);
+  if (trace) fprintf(trace, "C %02X\n", c);
+}
+
+void lcdBusData(const uint8_t* data, uint8_t len) {
+  if (len == 0 || len > 4) return;
+  for (uint8_t i = 0; i < len; i++) decodeParam(data[i]);
+  counters.dataBytes += len;
+  counters.transactions++;
+  countBytes(len);
+  if (trace) {
+    fputc('D', trace);
+    for (uint8_t i = 0; i < len; i++) fprintf(trace, " %02X", data[i]);
+    fputc('\n', trace);
+  }
+}
+
+void lcdBusSetWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+  uint16_t x1 = x + w - 1, y1 = y + h - 1;
+  uint8_t cols[4] = { (uint8_t)(x >> 8), (uint8_t)(x & 0xFF), (uint8_t)(x1 >> 8), (uint8_t)(x1 & 0xFF) };
+  uint8_t rows[4] = { (uint8_t)(y >> 8), (uint8_t)(y & 0xFF), (uint8_t)(y1 >> 8), (uint8_t)(y1 & 0xFF) };
+  lcdBusCommand(CASET); lcdBusData(cols, 4);
+  lcdBusCommand(RASET); lcdBusData(rows, 4);
+  lcdBusCommand(RAMWR);
+  counters.windows++;
+}
+
+uint8_t* lcdBusPixelBuffer() {
+  return pixelBuf[curBuf];
+}
+
+void lcdBusQueuePixels(uint32_t bytes) {
+  if (bytes == 0) return;
+  // RAMWR data only lands while RAMWR is the open command, as on the panel
+  if (cmd == RAMWR) for (uint32_t i = 0; i < bytes; i++) decodePixelByte(pixelBuf[curBuf][i]);
+  counters.pixelBytes += bytes;
+  counters.transactions++;
+  countBytes(bytes);
+  if (trace) fprintf(trace, "P %u\n", bytes);
+  // The next buffer handed out holds garbage, as it would after DMA; code
+  // that relies on stale contents shows up as 0xAAAA pixels
+  curBuf ^= 1;
+  memset(pixelBuf[curBuf], 0xAA, LCD_BUS_BUFFER_BYTES);
+}
+
+void lcdBusWait() {}
+
+uint32_t lcdBusBytesSent() { return bytesTotal; }
+
+#if DISPLAY_STATS
+void lcdBusStats(uint32_t& transactions, uint32_t& windows) {
+  transactions = counters.transactions;
+  windows = counters.windows;
+}
+#endif
+
+// --- HARNESS API ---
+void panelResetCounters() { memset(&counters, 0, sizeof(counters)); }
+PanelCounters panelCounters() { return counters; }
+
+uint16_t panelMemoryPixel(int x, int y) { return memory[y][x]; }
+
+uint16_t panelGlassPixel(int x, int y) {
+  // Scroll runs along columns in landscape; fixed areas stay put
+  if (x >= scrollTop && x < scrollTop + scrollArea && scrollArea > 0) {
+    x = scrollTop + (x - scrollTop + scrollStart - scrollTop + scrollArea) % scrollArea;
+  }
+  return memory[y][x];
+}
+
+bool panelWritePPM(const char* path) {
+  FILE* f = fopen(path, "wb");
+  if (f == NULL) return false;
+  fprintf(f, "P6\n%d %d\n255\n", PANEL_W, PANEL_H);
+  for (int y = 0; y < PANEL_H; y++) {
+    for (int x = 0; x < PANEL_W; x++) {
+      // Firmware colors are plain RGB565 (MADCTL's BGR bit matches the panel's order)
+      uint16_t c = panelGlassPixel(x, y);
+      uint8_t rgb[3] = { (uint8_t)(((c >> 11) & 0x1F) * 255 / 31),
+                         (uint8_t)(((c >> 5) & 0x3F) * 255 / 63),
+                         (uint8_t)((c & 0x1F) * 255 / 31) };
+      fwrite(rgb, 1, 3, f);
+    }
+  }
+  fclose(f);
+  return true;
+}
+
+void panelTrace(FILE* out) { trace = out; }
@@ -0,0 +1,35 @@
+#ifndef VIRTUAL_PANEL_H
+#define VIRTUAL_PANEL_H
+
+#include <Arduino.h>
+
+// --- VIRTUAL ST7796 ---
+// Host stand-in for LcdBus.cpp: implements the LcdBus.h API, decodes
+// CASET/RASET/RAMWR/VSCRDEF/VSCRSADD into a 480x320 RGB565 framebuffer
+// and accounts for every byte the real bus would have clocked out.
+#define PANEL_W 480
+#define PANEL_H 320
+
+struct PanelCounters {
+  uint32_t bytes;          // Everything on the wire (commands + data + pixels)
+  uint32_t commandBytes;
+  uint32_t dataBytes;      // Parameter bytes (CASET/RASET/MADCTL/...)
+  uint32_t pixelBytes;     // RAMWR payload
+  uint32_t transactions;   // Queued SPI transactions, as LcdBus.cpp counts them
+  uint32_t windows;        // CASET/RASET/RAMWR triplets
+};
+
+void panelResetCounters();
+PanelCounters panelCounters();
+
+// Memory as written, and as seen on the glass (scroll applied)
+uint16_t panelMemoryPixel(int x, int y);
+uint16_t panelGlassPixel(int x, int y);
+
+// Binary PPM of the glass; false if the file can't be written
+bool panelWritePPM(const char* path);
+
+// One line per transaction ("C 2A", "D 00 00 01 DF", "P 3840") or NULL to stop
+void panelTrace(FILE* out);
+
+#endif
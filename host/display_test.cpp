@@ -0,0 +1,110 @@
+// Host display test: renders the main screens through the real DisplayHAL /
+// TickerUI code into the virtual panel, dumps each one as a PPM and reports
+// the bus cost per screen. Exits non-zero when a screen goes over budget.
+// Budgets hold for the DISPLAY_LIST build; without it the frames are only
+// rendered, for make test to compare.
+//
+//   make test            (frames land in out/ and out/nolist/)
+#include <Arduino.h>
+#include "DisplayHAL.h"
+#include "TickerUI.h"
+#include "NewsCore.h"
+#include "HostRuntime.h"
+#include "VirtualPanel.h"
+
+// --- FIXTURE ---
+static const struct { int source; const char* headline; const char* timeStr; const char* url; } fixture[3] = {
+  { 0, "Senate passes stopgap funding bill hours before shutdown deadline, sending it to the president",
+       "2:15 PM", "https://example.com/news/2026/02/senate-passes-stopgap-funding-bill" },
+  { 1, "Storm system brings record snowfall to the upper Midwest", "11:40 AM",
+       "https://example.com/weather/record-snowfall-midwest" },
+  { 2, "Markets rally as inflation cools for a third straight month; tech shares lead gains while energy lags behind on weaker oil",
+       "9:05 AM", "https://example.com/markets/rally-inflation-cools" }
+};
+
+static void loadFixture() {
+  megaPool.clear();
+  for (int i = 0; i < 3; i++) {
+    Story s;
+    s.headline = fixture[i].headline;
+    s.headline.toUpperCase();
+    s.timeStr = fixture[i].timeStr;
+    s.url = fixture[i].url;
+    s.timestamp = 0;
+    s.sourceIndex = fixture[i].source;
+    layoutHeadline(s);
+    megaPool.push_back(s);
+  }
+  megaPoolGeneration++;
+}
+
+// --- SCREENS ---
+// Budgets are total bus bytes for the screen; raise them only on purpose
+struct Screen {
+  const char* name;
+  void (*draw)();
+  uint32_t budgetBytes;
+};
+
+static void drawSplash() {
+  hostHoldTouch(1000);   // Long press so the splash returns at once
+  drawSplashScreen();
+}
+
+static void drawHeaderScreen() { drawHeader(); }
+
+static void drawRows() {
+  for (int r = 0; r < 3; r++) drawRowDirect(r, r);
+}
+
+// One full update interval of idle loop() passes at 100/s: only the header
+// widgets draw, and only what changed, so the budget is bytes per interval
+static void drawIdle() {
+  drawHeader();
+  drawSyncStatus(UPDATE_INTERVAL_MS, false, (long)UPDATE_INTERVAL_MS, 0);
+  panelResetCounters();
+  unsigned long start = millis(), lastWifi = start;
+  while (millis() - start < UPDATE_INTERVAL_MS) {
+    drawSyncStatus((long)UPDATE_INTERVAL_MS - (long)(millis() - start), false, (long)UPDATE_INTERVAL_MS, 0);
+    if (millis() - lastWifi >= 2000) { drawWiFiIcon(); lastWifi = millis(); }
+    delay(10);
+  }
+}
+
+static void drawQR() {
+  drawQRCode(megaPool[0].url.c_str(), sources[megaPool[0].sourceIndex].name.c_str());
+}
+
+static const Screen screens[] = {
+  { "splash", drawSplash,       325908 },
+  { "header", drawHeaderScreen, 19585 },
+  { "rows",   drawRows,         288033 },
+  { "idle",   drawIdle,         7200 },
+  { "qr",     drawQR,           319565 },
+};
+
+int main(int argc, char** argv) {
+  const char* outDir = argc > 1 ? argv[1] : ".";
+  initDisplay();
+  loadFixture();
+
+  int failures = 0;
+  printf("%-8s %10s %8s %8s %8s %8s\n", "screen", "bytes", "pixels", "params", "trans", "windows");
+  for (size_t i = 0; i < sizeof(screens) / sizeof(screens[0]); i++) {
+    const Screen& sc = screens[i];
+    panelResetCounters();
+    sc.draw();
+    displayFlush();
+    PanelCounters c = panelCounters();
+
+    char path[256];
+    snprintf(path, sizeof(path), "%s/%s.ppm", outDir, sc.name);
+    if (!panelWritePPM(path)) { printf("cannot write %s\n", path); failures++; }
+
+    bool over = DISPLAY_LIST && sc.budgetBytes && c.bytes > sc.budgetBytes;
+    printf("%-8s %10u %8u %8u %8u %8u%s\n", sc.name, c.bytes, c.pixelBytes / 2, c.dataBytes,
+           c.transactions, c.windows, over ? "  OVER BUDGET" : "");
+    if (over) failures++;
+  }
+  return failures ? 1 : 0;
+}
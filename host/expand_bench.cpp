@@ -0,0 +1,139 @@
+// Color-expansion microbenchmark: checks the LUT kernel in ColorExpand.cpp
+// against the per-pixel branchy loop it replaced, then times both on
+// glyph-row and QR-module shaped input.
+//
+//   make bench
+#include <Arduino.h>
+#include <chrono>
+#include "ColorExpand.h"
+
+static inline uint16_t wire(uint16_t c) { return (uint16_t)((c << 8) | (c >> 8)); }
+
+// --- REFERENCE (per pixel, as renderGlyphs/renderMono used to do it) ---
+static uint16_t* refBits(uint16_t* out, uint32_t mask, int count, uint16_t fg, uint16_t bg) {
+  for (int i = 0; i < count; i++) { *out++ = wire((mask & 1) ? fg : bg); mask >>= 1; }
+  return out;
+}
+
+static uint16_t* refStream(uint16_t* out, const uint8_t* bits, uint32_t bit, int count, int scale, uint16_t fg, uint16_t bg) {
+  for (int i = 0; i < count; i++, bit++) {
+    uint16_t c = wire((bits[bit >> 3] & (0x80 >> (bit & 7))) ? fg : bg);
+    for (int s = 0; s < scale; s++) *out++ = c;
+  }
+  return out;
+}
+
+// --- CORRECTNESS ---
+static uint16_t outRef[4096], outLut[4096];
+static uint8_t stream[512];
+
+static bool verify() {
+  const uint16_t fg = 0xF800, bg = 0x07E5;
+  expandSetColors(fg, bg);
+  for (int trial = 0; trial < 20000; trial++) {
+    uint32_t mask = ((uint32_t)rand() << 16) ^ rand();
+    int count = rand() % 33;
+    uint16_t* end = refBits(outRef, mask, count, fg, bg);
+    if (expandBits(outLut, mask, count) - outLut != end - outRef || memcmp(outRef, outLut, count * 2)) {
+      printf("expandBits mismatch: mask %08x count %d\n", mask, count);
+      return false;
+    }
+  }
+  for (size_t i = 0; i < sizeof(stream); i++) stream[i] = rand();
+  for (int trial = 0; trial < 20000; trial++) {
+    uint32_t bit = rand() % 2048;
+    int scale = 1 + rand() % 12;
+    int count = rand() % (4096 / scale / 2 + 1);
+    if (bit + count > sizeof(stream) * 8) continue;
+    uint16_t* end = refStream(outRef, stream, bit, count, scale, fg, bg);
+    int n = end - outRef;
+    if (expandBitstream(outLut, stream, bit, count, scale) - outLut != n || memcmp(outRef, outLut, n * 2)) {
+      printf("expandBitstream mismatch: bit %u count %d scale %d\n", bit, count, scale);
+      return false;
+    }
+  }
+  return true;
+}
+
+// --- TIMING ---
+typedef std::chrono::steady_clock Clock;
+static double nsSince(Clock::time_point t0) {
+  return std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+}
+
+static volatile uint16_t sink;
+
+static void benchGlyphRows(int cellW, int iterations) {
+  // One 38-cell story line, 8 rows per cell, as renderGlyphs walks it
+  static uint32_t masks[38 * 8];
+  for (int i = 0; i < 38 * 8; i++) masks[i] = rand() & ((1u << cellW) - 1);
+  const uint16_t fg = 0xFFFF, bg = 0x001F;
+  double pixels = (double)iterations * 38 * 8 * cellW;
+
+  Clock::time_point t0 = Clock::now();
+  for (int it = 0; it < iterations; it++) {
+    uint16_t* out = outRef;
+    for (int r = 0; r < 8; r++) {
+      out = outRef;
+      for (int n = 0; n < 38; n++) out = refBits(out, masks[r * 38 + n], cellW, fg, bg);
+    }
+    sink = outRef[it & 255];
+  }
+  double refNs = nsSince(t0);
+
+  t0 = Clock::now();
+  for (int it = 0; it < iterations; it++) {
+    expandSetColors(fg, bg);
+    uint16_t* out = outLut;
+    for (int r = 0; r < 8; r++) {
+      out = outLut;
+      for (int n = 0; n < 38; n++) out = expandBits(out, masks[r * 38 + n], cellW);
+    }
+    sink = outLut[it & 255];
+  }
+  double lutNs = nsSince(t0);
+  printf("glyph rows  %2d px/cell   ref %6.2f ns/px   lut %6.2f ns/px   x%.1f\n",
+         cellW, refNs / pixels, lutNs / pixels, refNs / lutNs);
+}
+
+static void benchStream(int modules, int scale, int iterations) {
+  // A QR grid row by row (or a scale 1 mono blit)
+  double pixels = (double)iterations * modules * modules * scale;
+  const uint16_t fg = 0x0000, bg = 0xFFFF;
+
+  Clock::time_point t0 = Clock::now();
+  for (int it = 0; it < iterations; it++) {
+    for (int row = 0; row < modules; row++) refStream(outRef, stream, row * modules, modules, scale, fg, bg);
+    sink = outRef[it & 255];
+  }
+  double refNs = nsSince(t0);
+
+  t0 = Clock::now();
+  for (int it = 0; it < iterations; it++) {
+    expandSetColors(fg, bg);
+    for (int row = 0; row < modules; row++) expandBitstream(outLut, stream, row * modules, modules, scale);
+    sink = outLut[it & 255];
+  }
+  double lutNs = nsSince(t0);
+  printf("bitstream   %2d x%-2d       ref %6.2f ns/px   lut %6.2f ns/px   x%.1f\n",
+         modules, scale, refNs / pixels, lutNs / pixels, refNs / lutNs);
+}
+
+static void benchRebuild(int iterations) {
+  Clock::time_point t0 = Clock::now();
+  for (int it = 0; it < iterations; it++) expandSetColors(it & 0xFFFF, ~it & 0xFFFF);
+  printf("table rebuild               %8.0f ns\n", nsSince(t0) / iterations);
+}
+
+int main() {
+  srand(1);
+  if (!verify()) return 1;
+  printf("kernel matches reference\n");
+  benchGlyphRows(6, 20000);
+  benchGlyphRows(12, 20000);
+  benchGlyphRows(18, 20000);
+  benchStream(57, 1, 20000);
+  benchStream(33, 7, 5000);
+  benchRebuild(20000);
+  return 0;
+}
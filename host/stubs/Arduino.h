@@ -0,0 +1,147 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// Minimal Arduino core for the host display harness: only what the
+// firmware sources use. Time is virtual and only moves on delay().
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include <string>
+#include <algorithm>
+
+#define HIGH   1
+#define LOW    0
+#define INPUT  0
+#define OUTPUT 1
+#define IRAM_ATTR
+
+typedef bool boolean;
+using std::min;
+using std::max;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void yield();
+void pinMode(int pin, int mode);
+void digitalWrite(int pin, int level);
+int digitalRead(int pin);
+long random(long maxVal);
+long random(long minVal, long maxVal);
+void randomSeed(unsigned long seed);
+inline long map(long x, long inMin, long inMax, long outMin, long outMax) {
+  return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+template <class T, class L, class H> T constrain(T x, L lo, H hi) { return x < lo ? lo : (x > hi ? hi : x); }
+
+class String {
+public:
+  String() {}
+  String(const char* c) : s(c ? c : "") {}
+  String(const std::string& x) : s(x) {}
+  String(char c) : s(1, c) {}
+  String(int v) : s(std::to_string(v)) {}
+  String(unsigned int v) : s(std::to_string(v)) {}
+  String(long v) : s(std::to_string(v)) {}
+  String(unsigned long v) : s(std::to_string(v)) {}
+
+  const char* c_str() const { return s.c_str(); }
+  unsigned int length() const { return s.size(); }
+  bool reserve(unsigned int n) { s.reserve(n); return true; }
+  char charAt(unsigned int i) const { return i < s.size() ? s[i] : 0; }
+  char operator[](unsigned int i) const { return charAt(i); }
+
+  String& operator+=(const String& o) { s += o.s; return *this; }
+  String& operator+=(const char* o) { s += o; return *this; }
+  String& operator+=(char c) { s += c; return *this; }
+  bool concat(const String& o) { s += o.s; return true; }
+  bool concat(const char* p, unsigned int n) { s.append(p, n); return true; }
+  bool concat(char c) { s += c; return true; }
+  friend String operator+(const String& a, const String& b) { return String(a.s + b.s); }
+  friend String operator+(const String& a, const char* b) { return String(a.s + b); }
+  friend String operator+(const char* a, const String& b) { return String(a + b.s); }
+
+  bool operator==(const String& o) const { return s == o.s; }
+  bool operator!=(const String& o) const { return s != o.s; }
+  bool operator==(const char* o) const { return s == o; }
+  bool operator!=(const char* o) const { return s != o; }
+  bool operator<(const String& o) const { return s < o.s; }
+
+  int indexOf(char c, unsigned int from = 0) const { return pos(s.find(c, from)); }
+  int indexOf(const String& t, unsigned int from = 0) const { return pos(s.find(t.s, from)); }
+  int indexOf(const char* t, unsigned int from = 0) const { return pos(s.find(t, from)); }
+  int lastIndexOf(char c) const { return pos(s.rfind(c)); }
+  int lastIndexOf(char c, unsigned int from) const { return pos(s.rfind(c, from)); }
+  int lastIndexOf(const char* t) const { return pos(s.rfind(t)); }
+  String substring(unsigned int a) const { return a >= s.size() ? String() : String(s.substr(a)); }
+  String substring(unsigned int a, unsigned int b) const {
+    if (a > b) std::swap(a, b);
+    return a >= s.size() ? String() : String(s.substr(a, b - a));
+  }
+  void replace(const String& f, const String& t) {
+    if (f.s.empty()) return;
+    size_t p = 0;
+    while ((p = s.find(f.s, p)) != std::string::npos) { s.replace(p, f.s.size(), t.s); p += t.s.size(); }
+  }
+  void replace(char f, char t) { for (size_t i = 0; i < s.size(); i++) if (s[i] == f) s[i] = t; }
+  void remove(unsigned int i) { if (i < s.size()) s.erase(i); }
+  void remove(unsigned int i, unsigned int n) { if (i < s.size()) s.erase(i, n); }
+  void trim() {
+    size_t a = s.find_first_not_of(" \t\r\n");
+    if (a == std::string::npos) { s.clear(); return; }
+    s = s.substr(a, s.find_last_not_of(" \t\r\n") - a + 1);
+  }
+  void toUpperCase() { for (size_t i = 0; i < s.size(); i++) s[i] = toupper(s[i]); }
+  void toLowerCase() { for (size_t i = 0; i < s.size(); i++) s[i] = tolower(s[i]); }
+  bool startsWith(const String& p) const { return s.compare(0, p.s.size(), p.s) == 0; }
+  bool endsWith(const String& p) const { return s.size() >= p.s.size() && s.compare(s.size() - p.s.size(), p.s.size(), p.s) == 0; }
+  bool equalsIgnoreCase(const String& o) const { return strcasecmp(s.c_str(), o.s.c_str()) == 0; }
+  long toInt() const { return atol(s.c_str()); }
+  bool isEmpty() const { return s.empty(); }
+
+private:
+  std::string s;
+  static int pos(size_t p) { return p == std::string::npos ? -1 : (int)p; }
+};
+
+class Print {
+public:
+  size_t print(const String& v) { return fputs(v.c_str(), stdout), v.length(); }
+  size_t print(const char* v) { return fputs(v, stdout), strlen(v); }
+  size_t print(char v) { return putchar(v), 1; }
+  size_t print(int v) { return printf("%d", v); }
+  size_t print(unsigned int v) { return printf("%u", v); }
+  size_t print(long v) { return printf("%ld", v); }
+  size_t print(unsigned long v) { return printf("%lu", v); }
+  size_t print(double v, int digits = 2) { return printf("%.*f", digits, v); }
+  template <class T> size_t println(T v) { size_t n = print(v); putchar('\n'); return n + 1; }
+  size_t println(double v, int digits) { size_t n = print(v, digits); putchar('\n'); return n + 1; }
+  size_t println() { putchar('\n'); return 1; }
+};
+
+class Stream : public Print {
+public:
+  virtual ~Stream() {}
+  virtual int available() { return 0; }
+  virtual int read() { return -1; }
+  virtual int peek() { return -1; }
+  void setTimeout(unsigned long) {}
+};
+
+class HardwareSerial : public Stream {
+public:
+  void begin(unsigned long) {}
+};
+extern HardwareSerial Serial;
+
+struct EspClass {
+  uint32_t getFreeHeap() { return 200000; }
+  uint32_t getMaxAllocHeap() { return 100000; }
+  void restart() { exit(1); }
+};
+extern EspClass ESP;
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef HOST_WIFI_H
+#define HOST_WIFI_H
+
+// Always "connected" with a fixed signal so header widgets draw
+#include "Arduino.h"
+
+#define WL_CONNECTED 3
+
+struct IPAddress {
+  String toString() const { return "192.168.1.50"; }
+};
+
+class WiFiClient : public Stream {
+public:
+  using Stream::read;
+  virtual int read(uint8_t* buf, size_t size) {
+    int n = 0;
+    while (n < (int)size && available() > 0) buf[n++] = read();
+    return n;
+  }
+  virtual size_t write(const uint8_t*, size_t) { return 0; }
+  virtual int connected() { return 0; }
+  virtual void stop() {}
+};
+
+struct WiFiClass {
+  int status() { return WL_CONNECTED; }
+  int RSSI() { return -62; }
+  IPAddress localIP() { return IPAddress(); }
+  String SSID() { return "HostNet"; }
+  bool reconnect() { return true; }
+};
+extern WiFiClass WiFi;
+
+#endif
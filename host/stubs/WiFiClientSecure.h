@@ -0,0 +1,13 @@
+#ifndef HOST_WIFI_CLIENT_SECURE_H
+#define HOST_WIFI_CLIENT_SECURE_H
+
+#include "WiFi.h"
+
+class WiFiClientSecure : public WiFiClient {
+public:
+  void setInsecure() {}
+  void setTimeout(uint32_t) {}
+  virtual int connect(const char*, uint16_t) { return 0; }   // No network on the host
+};
+
+#endif
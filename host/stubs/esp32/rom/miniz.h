@@ -0,0 +1,69 @@
+#ifndef HOST_ROM_MINIZ_H
+#define HOST_ROM_MINIZ_H
+
+// The slice of the ROM's tinfl that FeedReader.cpp uses, on top of the
+// host's zlib (link with -lz). zlib keeps its own window, so the wrapping
+// output buffer only has to be written in order.
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <zlib.h>
+
+typedef uint8_t mz_uint8;
+typedef uint32_t mz_uint32;
+
+#define TINFL_LZ_DICT_SIZE 32768
+
+enum {
+  TINFL_FLAG_PARSE_ZLIB_HEADER = 1,
+  TINFL_FLAG_HAS_MORE_INPUT = 2,
+  TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF = 4,
+  TINFL_FLAG_COMPUTE_ADLER32 = 8
+};
+
+typedef enum {
+  TINFL_STATUS_BAD_PARAM = -3,
+  TINFL_STATUS_ADLER32_MISMATCH = -2,
+  TINFL_STATUS_FAILED = -1,
+  TINFL_STATUS_DONE = 0,
+  TINFL_STATUS_NEEDS_MORE_INPUT = 1,
+  TINFL_STATUS_HAS_MORE_OUTPUT = 2
+} tinfl_status;
+
+struct tinfl_decompressor {
+  mz_uint32 m_state;   // 0 until the first call after tinfl_init
+  z_stream z;
+};
+
+#define tinfl_init(r) do { (r)->m_state = 0; } while (0)
+
+inline tinfl_status tinfl_decompress(tinfl_decompressor* r, const mz_uint8* pIn_buf_next, size_t* pIn_buf_size,
+                                     mz_uint8* pOut_buf_start, mz_uint8* pOut_buf_next, size_t* pOut_buf_size,
+                                     const mz_uint32 decomp_flags) {
+  (void)pOut_buf_start;
+  if (r->m_state == 0) {
+    // Callers allocate zeroed, so a stream left open by an abandoned body shows here
+    if (r->z.state) inflateEnd(&r->z);
+    memset(&r->z, 0, sizeof(r->z));
+    if (inflateInit2(&r->z, (decomp_flags & TINFL_FLAG_PARSE_ZLIB_HEADER) ? 15 : -15) != Z_OK) return TINFL_STATUS_FAILED;
+    r->m_state = 1;
+  }
+  r->z.next_in = (Bytef*)pIn_buf_next;
+  r->z.avail_in = (uInt)*pIn_buf_size;
+  r->z.next_out = pOut_buf_next;
+  r->z.avail_out = (uInt)*pOut_buf_size;
+  int ret = inflate(&r->z, Z_NO_FLUSH);
+  *pIn_buf_size -= r->z.avail_in;
+  *pOut_buf_size -= r->z.avail_out;
+
+  tinfl_status status;
+  if (ret == Z_STREAM_END) status = TINFL_STATUS_DONE;
+  else if (ret != Z_OK && ret != Z_BUF_ERROR) status = TINFL_STATUS_FAILED;
+  else if (r->z.avail_out == 0) status = TINFL_STATUS_HAS_MORE_OUTPUT;
+  else if (decomp_flags & TINFL_FLAG_HAS_MORE_INPUT) status = TINFL_STATUS_NEEDS_MORE_INPUT;
+  else status = TINFL_STATUS_FAILED;   // Input ran out with no more to come
+  if (status <= TINFL_STATUS_DONE) inflateEnd(&r->z);
+  return status;
+}
+
+#endif